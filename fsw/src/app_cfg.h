@@ -60,11 +60,28 @@
 #define CFG_APP_CMD_PIPE_TIMEOUT      APP_CMD_PIPE_TIMEOUT
 #define CFG_APP_CMD_PIPE_EXE_MSG_LIM  APP_CMD_PIPE_EXE_MSG_LIM
 #define CFG_APP_CMD_PIPE_ACT_MSG_LIM  APP_CMD_PIPE_ACT_MSG_LIM
+#define CFG_APP_ACT_PIPE_DEPTH        APP_ACT_PIPE_DEPTH
+#define CFG_APP_ACT_PIPE_NAME         APP_ACT_PIPE_NAME
+#define CFG_APP_ACT_PIPE_TIMEOUT      APP_ACT_PIPE_TIMEOUT
 
 #define CFG_BC42_INTF_CMD_TOPICID              BC42_INTF_CMD_TOPICID
 #define CFG_BC42_INTF_STATUS_TLM_TOPICID       BC42_INTF_STATUS_TLM_TOPICID
+#define CFG_BC42_INTF_DIAG_TLM_TOPICID         BC42_INTF_DIAG_TLM_TOPICID
 #define CFG_BC42_INTF_SENSOR_DATA_MSG_TOPICID  BC42_INTF_SENSOR_DATA_MSG_TOPICID
 #define CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID BC42_INTF_ACTUATOR_CMD_MSG_TOPICID
+#define CFG_BC42_INTF_SENSOR_DATA_MSG_2_TOPICID  BC42_INTF_SENSOR_DATA_MSG_2_TOPICID
+#define CFG_BC42_INTF_ACTUATOR_CMD_MSG_2_TOPICID BC42_INTF_ACTUATOR_CMD_MSG_2_TOPICID
+#define CFG_BC42_INTF_SENSOR_DATA_MSG_3_TOPICID  BC42_INTF_SENSOR_DATA_MSG_3_TOPICID
+#define CFG_BC42_INTF_ACTUATOR_CMD_MSG_3_TOPICID BC42_INTF_ACTUATOR_CMD_MSG_3_TOPICID
+#define CFG_BC42_INTF_SENSOR_DATA_MSG_4_TOPICID  BC42_INTF_SENSOR_DATA_MSG_4_TOPICID
+#define CFG_BC42_INTF_ACTUATOR_CMD_MSG_4_TOPICID BC42_INTF_ACTUATOR_CMD_MSG_4_TOPICID
+#define CFG_BC42_INTF_SENSOR_DELTA_MSG_TOPICID   BC42_INTF_SENSOR_DELTA_MSG_TOPICID
+#define CFG_BC42_INTF_SENSOR_IMU_MSG_TOPICID      BC42_INTF_SENSOR_IMU_MSG_TOPICID
+#define CFG_BC42_INTF_SENSOR_ATTITUDE_MSG_TOPICID BC42_INTF_SENSOR_ATTITUDE_MSG_TOPICID
+#define CFG_BC42_INTF_SENSOR_NAV_MSG_TOPICID      BC42_INTF_SENSOR_NAV_MSG_TOPICID
+#define CFG_BC42_INTF_SENSOR_SUN_MAG_MSG_TOPICID  BC42_INTF_SENSOR_SUN_MAG_MSG_TOPICID
+#define CFG_BC42_INTF_SENSOR_WHEEL_MSG_TOPICID    BC42_INTF_SENSOR_WHEEL_MSG_TOPICID
+#define CFG_BC42_INTF_SIM_TICK_MSG_TOPICID        BC42_INTF_SIM_TICK_MSG_TOPICID
 #define CFG_BC42_INTF_EXECUTE_TOPICID          BC_SCH_1_HZ_TOPICID    // Use different CFG_ name instead of BC_SCH_*_TOPICID to localize impact if rate changes
 
 #define CFG_CHILD_NAME        CHILD_NAME
@@ -80,10 +97,49 @@
 #define CFG_EXE_CYCLE_DELAY_MAX     EXE_CYCLE_DELAY_MAX
 #define CFG_EXE_CYCLE_DELAY_DEF     EXE_CYCLE_DELAY_DEF
 #define CFG_EXE_UNCLOSED_CYCLE_LIM  EXE_UNCLOSED_CYCLE_LIM
+#define CFG_EXE_FREE_RUN_DEF        EXE_FREE_RUN_DEF
+#define CFG_EXE_SIM_RATE_DEF        EXE_SIM_RATE_DEF
+#define CFG_EXE_SENSOR_PREFETCH     EXE_SENSOR_PREFETCH
 
 #define CFG_BC42_LOCAL_HOST_STR   BC42_LOCAL_HOST_STR
 #define CFG_BC42_SOCKET_ADDR_STR  BC42_SOCKET_ADDR_STR
 #define CFG_BC42_SOCKET_PORT      BC42_SOCKET_PORT
+#define CFG_BC42_SOCKET_PORT_2    BC42_SOCKET_PORT_2
+#define CFG_BC42_SOCKET_PORT_3    BC42_SOCKET_PORT_3
+#define CFG_BC42_SOCKET_PORT_4    BC42_SOCKET_PORT_4
+#define CFG_BC42_LINK_CNT         BC42_LINK_CNT
+
+#define CFG_BC42_TRANSPORT        BC42_TRANSPORT
+#define CFG_BC42_SHM_NAME         BC42_SHM_NAME
+#define CFG_BC42_SHM_NAME_2       BC42_SHM_NAME_2
+#define CFG_BC42_SHM_NAME_3       BC42_SHM_NAME_3
+#define CFG_BC42_SHM_NAME_4       BC42_SHM_NAME_4
+#define CFG_BC42_UDP_RESEND_TIMEOUT  BC42_UDP_RESEND_TIMEOUT
+
+#define CFG_BC42_CONNECT_TIMEOUT      BC42_CONNECT_TIMEOUT
+#define CFG_BC42_CONNECT_BACKOFF_MIN  BC42_CONNECT_BACKOFF_MIN
+#define CFG_BC42_CONNECT_BACKOFF_MAX  BC42_CONNECT_BACKOFF_MAX
+
+#define CFG_BC42_WIRE_PROTOCOL       BC42_WIRE_PROTOCOL
+#define CFG_BC42_WIRE_HELLO_TIMEOUT  BC42_WIRE_HELLO_TIMEOUT
+#define CFG_BC42_CHILD_WAIT_TIMEOUT  BC42_CHILD_WAIT_TIMEOUT
+#define CFG_BC42_SENSOR_TIMEOUT      BC42_SENSOR_TIMEOUT
+#define CFG_BC42_BATCH_STEPS         BC42_BATCH_STEPS
+#define CFG_BC42_SENSOR_MASK         BC42_SENSOR_MASK
+#define CFG_BC42_DELTA_MSG_ENA       BC42_DELTA_MSG_ENA
+#define CFG_BC42_DELTA_MSG_KEYFRAME  BC42_DELTA_MSG_KEYFRAME
+
+#define CFG_BC42_GROUP_IMU_DECIM      BC42_GROUP_IMU_DECIM
+#define CFG_BC42_GROUP_ATTITUDE_DECIM BC42_GROUP_ATTITUDE_DECIM
+#define CFG_BC42_GROUP_NAV_DECIM      BC42_GROUP_NAV_DECIM
+#define CFG_BC42_GROUP_SUN_MAG_DECIM  BC42_GROUP_SUN_MAG_DECIM
+#define CFG_BC42_GROUP_WHEEL_DECIM    BC42_GROUP_WHEEL_DECIM
+
+#define CFG_BC42_SIM_TICK_PERIOD  BC42_SIM_TICK_PERIOD
+
+#define CFG_TRACE_FILE   TRACE_FILE
+#define CFG_RECORD_FILE  RECORD_FILE
+#define CFG_CHECKPOINT_FILE  CHECKPOINT_FILE
       
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
@@ -93,10 +149,27 @@
    XX(APP_CMD_PIPE_TIMEOUT,uint32) \
    XX(APP_CMD_PIPE_EXE_MSG_LIM,uint32) \
    XX(APP_CMD_PIPE_ACT_MSG_LIM,uint32) \
+   XX(APP_ACT_PIPE_DEPTH,uint32) \
+   XX(APP_ACT_PIPE_NAME,char*) \
+   XX(APP_ACT_PIPE_TIMEOUT,uint32) \
    XX(BC42_INTF_CMD_TOPICID,uint32) \
    XX(BC42_INTF_STATUS_TLM_TOPICID,uint32) \
+   XX(BC42_INTF_DIAG_TLM_TOPICID,uint32) \
    XX(BC42_INTF_SENSOR_DATA_MSG_TOPICID,uint32) \
    XX(BC42_INTF_ACTUATOR_CMD_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_DATA_MSG_2_TOPICID,uint32) \
+   XX(BC42_INTF_ACTUATOR_CMD_MSG_2_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_DATA_MSG_3_TOPICID,uint32) \
+   XX(BC42_INTF_ACTUATOR_CMD_MSG_3_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_DATA_MSG_4_TOPICID,uint32) \
+   XX(BC42_INTF_ACTUATOR_CMD_MSG_4_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_DELTA_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_IMU_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_ATTITUDE_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_NAV_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_SUN_MAG_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SENSOR_WHEEL_MSG_TOPICID,uint32) \
+   XX(BC42_INTF_SIM_TICK_MSG_TOPICID,uint32) \
    XX(BC_SCH_1_HZ_TOPICID,uint32) \
    XX(CHILD_NAME,char*) \
    XX(CHILD_STACK_SIZE,uint32) \
@@ -110,9 +183,42 @@
    XX(EXE_CYCLE_DELAY_MAX,uint32) \
    XX(EXE_CYCLE_DELAY_DEF,uint32) \
    XX(EXE_UNCLOSED_CYCLE_LIM,uint32) \
+   XX(EXE_FREE_RUN_DEF,uint32) \
+   XX(EXE_SIM_RATE_DEF,uint32) \
+   XX(EXE_SENSOR_PREFETCH,uint32) \
    XX(BC42_LOCAL_HOST_STR,char*) \
    XX(BC42_SOCKET_ADDR_STR,char*) \
    XX(BC42_SOCKET_PORT,uint32) \
+   XX(BC42_SOCKET_PORT_2,uint32) \
+   XX(BC42_SOCKET_PORT_3,uint32) \
+   XX(BC42_SOCKET_PORT_4,uint32) \
+   XX(BC42_LINK_CNT,uint32) \
+   XX(BC42_TRANSPORT,char*) \
+   XX(BC42_SHM_NAME,char*) \
+   XX(BC42_SHM_NAME_2,char*) \
+   XX(BC42_SHM_NAME_3,char*) \
+   XX(BC42_SHM_NAME_4,char*) \
+   XX(BC42_UDP_RESEND_TIMEOUT,uint32) \
+   XX(BC42_CONNECT_TIMEOUT,uint32) \
+   XX(BC42_CONNECT_BACKOFF_MIN,uint32) \
+   XX(BC42_CONNECT_BACKOFF_MAX,uint32) \
+   XX(BC42_WIRE_PROTOCOL,char*) \
+   XX(BC42_WIRE_HELLO_TIMEOUT,uint32) \
+   XX(BC42_CHILD_WAIT_TIMEOUT,uint32) \
+   XX(BC42_SENSOR_TIMEOUT,uint32) \
+   XX(BC42_BATCH_STEPS,uint32) \
+   XX(BC42_SENSOR_MASK,uint32) \
+   XX(BC42_DELTA_MSG_ENA,uint32) \
+   XX(BC42_DELTA_MSG_KEYFRAME,uint32) \
+   XX(BC42_GROUP_IMU_DECIM,uint32) \
+   XX(BC42_GROUP_ATTITUDE_DECIM,uint32) \
+   XX(BC42_GROUP_NAV_DECIM,uint32) \
+   XX(BC42_GROUP_SUN_MAG_DECIM,uint32) \
+   XX(BC42_GROUP_WHEEL_DECIM,uint32) \
+   XX(BC42_SIM_TICK_PERIOD,uint32) \
+   XX(TRACE_FILE,char*) \
+   XX(RECORD_FILE,char*) \
+   XX(CHECKPOINT_FILE,char*) \
 
 DECLARE_ENUM(Config,APP_CONFIG)
 
@@ -134,6 +240,11 @@ DECLARE_ENUM(Config,APP_CONFIG)
 
 #define BC42_INTF_BASE_EID  (APP_C_FW_APP_BASE_EID +  0)
 #define COMM42_BASE_EID     (APP_C_FW_APP_BASE_EID + 20)
+#define WIRE42_BASE_EID     (APP_C_FW_APP_BASE_EID + 40)
+#define TRACE42_BASE_EID    (APP_C_FW_APP_BASE_EID + 60)
+#define REC42_BASE_EID      (APP_C_FW_APP_BASE_EID + 80)
+#define SHM42_BASE_EID      (APP_C_FW_APP_BASE_EID + 100)
+#define CKPT42_BASE_EID     (APP_C_FW_APP_BASE_EID + 120)
 
 /*
 ** One event ID is used for all initialization debug messages. Uncomment one of
@@ -146,6 +257,20 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define BC42_INTF_INIT_EVS_TYPE CFE_EVS_DEBUG
 //#define BC42_INTF_INIT_EVS_TYPE CFE_EVS_INFORMATION
 
+/*
+** Events sent every control cycle are formatted even when they are filtered
+** so they are compiled out unless BC42_INTF_CYCLE_EVS is set to 1. The
+** COMM42 cycle trace records the same information. 
+*/
+
+#define BC42_INTF_CYCLE_EVS  0
+
+#if (BC42_INTF_CYCLE_EVS == 1)
+   #define BC42_INTF_CYCLE_EVENT(...)  CFE_EVS_SendEvent(__VA_ARGS__)
+#else
+   #define BC42_INTF_CYCLE_EVENT(...)
+#endif
+
 /******************************************************************************
 ** BC42_INTF Macros
 */
@@ -51,7 +51,10 @@ static int32 InitApp(void);
 static int32 ProcessCmdPipe(void);
 static void AppTermCallback(void);
 
+static uint32 ExecuteDeadlineWait(void);
+static void RunExecuteCycle(void);
 static void SendHousekeepingPkt(void);
+static void SendDiagPkt(void);
 
 /**********************/
 /** File Global Data **/
@@ -67,7 +70,10 @@ static CFE_EVS_BinFilter_t  EventFilters[] =
 {  
    /* Event ID                           Mask */
    {COMM42_DEBUG_EID,    CFE_EVS_FIRST_64_STOP}, //CFE_EVS_NO_FILTER
-   {BC42_INTF_DEBUG_EID, CFE_EVS_FIRST_64_STOP}
+   {BC42_INTF_DEBUG_EID, CFE_EVS_FIRST_64_STOP},
+   {COMM42_CYCLE_TAG_EID, CFE_EVS_FIRST_16_STOP},
+   {COMM42_ACTUATOR_LEN_EID, CFE_EVS_FIRST_16_STOP},
+   {WIRE42_RECV_FRAME_EID,   CFE_EVS_FIRST_16_STOP}
 };
 
 /*****************/
@@ -130,7 +136,28 @@ bool BC42_INTF_ConfigExecuteCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPt
    uint16  SavedExecuteMsgCycles  = Bc42Intf.ExecuteMsgCycles;
    uint16  SavedExecuteCycleDelay = Bc42Intf.ExecuteCycleDelay;
   
-   if ((Cmd->MsgCycles >= Bc42Intf.ExecuteMsgCycleMin) &&
+   if (Cmd->FreeRun == true)
+   {
+      
+      Bc42Intf.ExecuteFreeRun = true;
+      COMM42_SetFreeRun(true);
+      COMM42_SetSimRate(Cmd->SimRate);
+      
+      RetStatus = true;
+      if (Cmd->SimRate == 0)
+      {
+         CFE_EVS_SendEvent(BC42_INTF_EXECUTE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Execution changed to free running. Each cycle starts when the previous cycle closes");
+      }
+      else
+      {
+         CFE_EVS_SendEvent(BC42_INTF_EXECUTE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                           "Execution changed to free running paced at %d sim seconds per wall clock second",
+                           Cmd->SimRate);
+      }
+   
+   }
+   else if ((Cmd->MsgCycles >= Bc42Intf.ExecuteMsgCycleMin) &&
        (Cmd->MsgCycles <= Bc42Intf.ExecuteMsgCycleMax))
    {
       
@@ -140,6 +167,8 @@ bool BC42_INTF_ConfigExecuteCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPt
       
          Bc42Intf.ExecuteMsgCycles  = Cmd->MsgCycles;
          Bc42Intf.ExecuteCycleDelay = Cmd->CycleDelay;
+         Bc42Intf.ExecuteFreeRun    = false;
+         COMM42_SetFreeRun(false);
 
          RetStatus = true;
          CFE_EVS_SendEvent(BC42_INTF_EXECUTE_CMD_EID, CFE_EVS_EventType_INFORMATION,
@@ -172,54 +201,77 @@ bool BC42_INTF_ConfigExecuteCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPt
 /******************************************************************************
 ** Function: BC42_INTF_ConnectCmd
 **
+** Notes:
+**   1. The child task performs the connection so this command doesn't wait
+**      for 42. The child task keeps retrying until a disconnect command.
+**   2. Empty or zero payload fields use the ini file's values.
 */
 bool BC42_INTF_ConnectCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   const BC42_INTF_ConnectCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_ConnectCmd_t);
    int32             CfeStatus;
    CFE_ES_AppId_t    AppId;
    CFE_ES_AppInfo_t  AppInfo;
    bool FailedToGetAppInfo = true;
-   bool RetStatus = false;
+   bool RetStatus = true;
+   char   AddrStr[BC42_INTF_IP_ADDR_STR_LEN];
+   uint16 Port = (Cmd->Port == 0) ? Bc42Intf.IpPort : Cmd->Port;
+   COMM42_Transport_t Transport = Bc42Intf.Comm42.TransportCfg;
    
-   COMM42_Close();
+   strncpy(AddrStr, (Cmd->IpAddrStr[0] == '\0') ? Bc42Intf.IpAddrStr : Cmd->IpAddrStr, BC42_INTF_IP_ADDR_STR_LEN);
+   AddrStr[BC42_INTF_IP_ADDR_STR_LEN-1] = '\0';
    
-   if (COMM42_ConnectSocket(Bc42Intf.IpAddrStr, Bc42Intf.IpPort))
+   if (Cmd->Transport > BC42_INTF_Transport_UDP)
    {
-      
-      RetStatus = true;
-      CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_INFORMATION,
-                        "Connected to 42 simulator on %s port %d", Bc42Intf.IpAddrStr, Bc42Intf.IpPort);
-
-      CfeStatus = CFE_ES_GetAppID(&AppId);
+      CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_ERROR,
+                        "Connect command rejected. Invalid transport %d, must be in range %d..%d",
+                        Cmd->Transport, BC42_INTF_Transport_INI, BC42_INTF_Transport_UDP);
+      return false;
+   }
+   if (Cmd->Transport != BC42_INTF_Transport_INI)
+   {
+      Transport = (COMM42_Transport_t)Cmd->Transport;
+   }
+   
+   COMM42_Close();
+   
+   CfeStatus = CFE_ES_GetAppID(&AppId);
+   if (CfeStatus == CFE_SUCCESS)
+   { 
+      CfeStatus = CFE_ES_GetAppInfo(&AppInfo, AppId);
       if (CfeStatus == CFE_SUCCESS)
-      { 
-         CfeStatus = CFE_ES_GetAppInfo(&AppInfo, AppId);
-         if (CfeStatus == CFE_SUCCESS)
+      {
+         FailedToGetAppInfo = false;
+         if (AppInfo.NumOfChildTasks == 0)
          {
-            FailedToGetAppInfo = false;
-            if (AppInfo.NumOfChildTasks == 0)
-            {
-         
-               CfeStatus = CHILDMGR_Constructor(CHILDMGR_OBJ, ChildMgr_TaskMainCallback, COMM42_SocketTask, &Bc42Intf.ChildTask);      
-               
-               if (CfeStatus != CFE_SUCCESS)
-               {   
-                  CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_ERROR,
-                                    "Failed to create child task durng socket connection, status=0x%8X", (int)CfeStatus);               
-                  COMM42_Close();
-                  RetStatus = false;
-               }
+      
+            CfeStatus = CHILDMGR_Constructor(CHILDMGR_OBJ, ChildMgr_TaskMainCallback, COMM42_SocketTask, &Bc42Intf.ChildTask);      
+            
+            if (CfeStatus != CFE_SUCCESS)
+            {   
+               CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_ERROR,
+                                 "Failed to create child task durng socket connection, status=0x%8X", (int)CfeStatus);               
+               RetStatus = false;
             }
          }
       }
-      if (FailedToGetAppInfo)
-      {
-         CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_INFORMATION,
-                           "Failed to get app info durng socket connection, status=0x%8X", (int)CfeStatus);                        
-      }
+   }
+   if (FailedToGetAppInfo)
+   {
+      CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_INFORMATION,
+                        "Failed to get app info durng socket connection, status=0x%8X", (int)CfeStatus);                        
+   }
+   
+   if (RetStatus)
+   {
+      
+      COMM42_ConnectSocket(AddrStr, Port, Transport);
       
-   } /* End if connected */
+      CFE_EVS_SendEvent(BC42_INTF_CONNECT_TO_42_EID, CFE_EVS_EventType_INFORMATION,
+                        "Connecting to 42 simulator on %s port %d using the %s transport", 
+                        AddrStr, Port, COMM42_TransportStr(Bc42Intf.Comm42.ConnectTransport));
+   }
 
    return RetStatus;
 
@@ -272,6 +324,10 @@ bool BC42_INTF_ResetAppCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
    
    COMM42_ResetStatus();
    
+   Bc42Intf.ExecuteOverrunCnt  = 0;
+   Bc42Intf.ExecuteLateMaxUsec = 0;
+   Bc42Intf.ExecuteDriftUsec   = 0;
+   
    return true;
 
 } /* End BC42_INTF_ResetAppCmd() */
@@ -322,14 +378,15 @@ static int32 InitApp(void)
       Bc42Intf.ExecuteCycleDelay    = INITBL_GetIntConfig(INITBL_OBJ, CFG_EXE_CYCLE_DELAY_DEF);
       Bc42Intf.ExecuteCycleDelayMin = INITBL_GetIntConfig(INITBL_OBJ, CFG_EXE_CYCLE_DELAY_MIN);
       Bc42Intf.ExecuteCycleDelayMax = INITBL_GetIntConfig(INITBL_OBJ, CFG_EXE_CYCLE_DELAY_MAX);
+      Bc42Intf.ExecuteFreeRun       = (INITBL_GetIntConfig(INITBL_OBJ, CFG_EXE_FREE_RUN_DEF) != 0);
 
       Bc42Intf.PerfId = INITBL_GetIntConfig(INITBL_OBJ, APP_PERF_ID);  
 
       Bc42Intf.CmdMid            = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_INTF_CMD_TOPICID));
       Bc42Intf.ExecuteMid        = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_INTF_EXECUTE_TOPICID));
-      Bc42Intf.ActuatorCmdMsgMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID));
 
       COMM42_Constructor(COMM42_OBJ, INITBL_OBJ);
+      COMM42_SetFreeRun(Bc42Intf.ExecuteFreeRun);
    
       /* Child Manager constructor sends error events */
       Bc42Intf.ChildTask.TaskName  = INITBL_GetStrConfig(INITBL_OBJ, CFG_CHILD_NAME);
@@ -349,16 +406,23 @@ static int32 InitApp(void)
       CFE_SB_CreatePipe(&Bc42Intf.CmdPipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_DEPTH), INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_NAME));
       CFE_SB_Subscribe(Bc42Intf.CmdMid, Bc42Intf.CmdPipe);
       CFE_SB_SubscribeEx(Bc42Intf.ExecuteMid, Bc42Intf.CmdPipe, SbQos, INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_EXE_MSG_LIM));
-      CFE_SB_SubscribeEx(Bc42Intf.ActuatorCmdMsgMid, Bc42Intf.CmdPipe, SbQos, INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_ACT_MSG_LIM));
 
       CMDMGR_Constructor(CMDMGR_OBJ);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_NOOP_CC,           NULL, BC42_INTF_NoOpCmd,          0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_RESET_CC,          NULL, BC42_INTF_ResetAppCmd,      0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_CONFIG_EXECUTE_CC, NULL, BC42_INTF_ConfigExecuteCmd, sizeof(BC42_INTF_ConfigExecuteCmd_Payload_t));
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_CONNECT_CC,        NULL, BC42_INTF_ConnectCmd,       0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_CONNECT_CC,        NULL, BC42_INTF_ConnectCmd,       sizeof(BC42_INTF_ConnectCmd_Payload_t));
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_DISCONNECT_CC,     NULL, BC42_INTF_DisconnectCmd,    0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_DUMP_TRACE_CC,     NULL, COMM42_DumpTraceCmd,        sizeof(BC42_INTF_DumpTraceCmd_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_START_RECORD_CC,   NULL, COMM42_StartRecordCmd,      sizeof(BC42_INTF_StartRecordCmd_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_STOP_RECORD_CC,    NULL, COMM42_StopRecordCmd,       0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_START_REPLAY_CC,   NULL, COMM42_StartReplayCmd,      sizeof(BC42_INTF_StartReplayCmd_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_SET_SENSOR_MASK_CC, NULL, COMM42_SetSensorMaskCmd,   sizeof(BC42_INTF_SetSensorMaskCmd_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_SAVE_CHECKPOINT_CC,    NULL, COMM42_SaveCheckpointCmd,    sizeof(BC42_INTF_SaveCheckpointCmd_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_INTF_RESTORE_CHECKPOINT_CC, NULL, COMM42_RestoreCheckpointCmd, sizeof(BC42_INTF_RestoreCheckpointCmd_Payload_t));
 
       CFE_MSG_Init(CFE_MSG_PTR(Bc42Intf.StatusTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_INTF_STATUS_TLM_TOPICID)), sizeof(BC42_INTF_StatusTlm_t));
+      CFE_MSG_Init(CFE_MSG_PTR(Bc42Intf.DiagTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_INTF_DIAG_TLM_TOPICID)), sizeof(BC42_INTF_DiagTlm_t));
 
           
       OS_TaskInstallDeleteHandler(AppTermCallback); /* Call when application terminates */
@@ -383,7 +447,15 @@ static int32 InitApp(void)
 ** This ExecuteLoop allows a user some control over how many simulator control
 ** cycles are executed for each scheduler wakeup. COMM42 manages the interface 
 ** details such as whether the interface is connected, previous control cycle
-** has completed, etc.
+** has completed, etc. When free running the loop isn't used because COMM42
+** starts each cycle when the previous cycle's actuator command is sent.
+** Actuator commands aren't received on this pipe, COMM42's child task
+** services them on its own actuator pipe.
+**
+** The execute message's additional cycles start at absolute deadlines spaced
+** ExecuteCycleDelay apart from the execute message so the cycle rate doesn't
+** drift with the cycles' execution time. The pipe is pended on until the next
+** deadline so commands are processed while waiting.
 */
 static int32 ProcessCmdPipe(void)
 {
@@ -393,6 +465,8 @@ static int32 ProcessCmdPipe(void)
    int32   MsgStatus;
    bool    ExecuteLoop  = false;
    uint16  ExecuteCycle = 0;
+   int32   SbTimeout;
+   uint32  WaitMsec;
    
    CFE_SB_Buffer_t  *SbBufPtr;
    CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
@@ -413,9 +487,9 @@ static int32 ProcessCmdPipe(void)
          if (MsgStatus == CFE_SUCCESS)
          {
    
-            CFE_EVS_SendEvent(BC42_INTF_DEBUG_EID, CFE_EVS_EventType_DEBUG,
-                              "***ProcessSbPipe(): ExecuteLoop=%d,  ExecuteCycle=%d, MsgId=0x%04X, SensorDataMsg.InitCycle=%d",
-                              ExecuteLoop,ExecuteCycle,CFE_SB_MsgIdToValue(MsgId),Bc42Intf.Comm42.SensorDataMsg.Payload.InitCycle);
+            BC42_INTF_CYCLE_EVENT(BC42_INTF_DEBUG_EID, CFE_EVS_EventType_DEBUG,
+                                  "***ProcessSbPipe(): ExecuteLoop=%d,  ExecuteCycle=%d, MsgId=0x%04X, Comm42.InitCycle=%d",
+                                  ExecuteLoop,ExecuteCycle,CFE_SB_MsgIdToValue(MsgId),Bc42Intf.Comm42.InitCycle);
          
             if (CFE_SB_MsgId_Equal(MsgId, Bc42Intf.CmdMid))
             {
@@ -423,14 +497,13 @@ static int32 ProcessCmdPipe(void)
             }
             else if (CFE_SB_MsgId_Equal(MsgId, Bc42Intf.ExecuteMid))
             {
+               CFE_PSP_GetTime(&Bc42Intf.ExecuteDeadline);
+               Bc42Intf.ExecuteDeadline = OS_TimeAdd(Bc42Intf.ExecuteDeadline, OS_TimeFromTotalMilliseconds(Bc42Intf.ExecuteCycleDelay));
                COMM42_ManageExecution();
                ++ExecuteCycle;
-               ExecuteLoop = true;
+               ExecuteLoop = !Bc42Intf.ExecuteFreeRun;
                SendHousekeepingPkt();
-            }
-            else if (CFE_SB_MsgId_Equal(MsgId, Bc42Intf.ActuatorCmdMsgMid))
-            {
-               COMM42_SendActuatorCmds((BC42_INTF_ActuatorCmdMsg_t *)&SbBufPtr->Msg);
+               SendDiagPkt();
             }
             else
             {            
@@ -443,13 +516,21 @@ static int32 ProcessCmdPipe(void)
 
       } /* End if SB received a packet */
       
+      SbTimeout = CFE_SB_POLL;
       if (ExecuteLoop) 
       {
          if (ExecuteCycle < Bc42Intf.ExecuteMsgCycles)
          {
-            OS_TaskDelay(Bc42Intf.ExecuteCycleDelay);
-            COMM42_ManageExecution();
-            ++ExecuteCycle;
+            WaitMsec = ExecuteDeadlineWait();
+            if (WaitMsec == 0)
+            {
+               RunExecuteCycle();
+               ++ExecuteCycle;
+            }
+            else
+            {
+               SbTimeout = WaitMsec;
+            }
          }
          else 
          {
@@ -458,12 +539,12 @@ static int32 ProcessCmdPipe(void)
       }
       
       CFE_ES_PerfLogExit(Bc42Intf.PerfId);
-      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Intf.CmdPipe, CFE_SB_POLL);
+      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Intf.CmdPipe, SbTimeout);
       CFE_ES_PerfLogEntry(Bc42Intf.PerfId);
    
    } while (ExecuteLoop || (SbStatus == CFE_SUCCESS));
    
-   if (SbStatus != CFE_SB_NO_MESSAGE)
+   if ((SbStatus != CFE_SB_NO_MESSAGE) && (SbStatus != CFE_SB_TIME_OUT))
    {
       RetStatus = CFE_ES_RunStatus_APP_ERROR;
    }
@@ -473,6 +554,67 @@ static int32 ProcessCmdPipe(void)
 } /* End ProcessCmdPipe() */
 
 
+/******************************************************************************
+** Function: ExecuteDeadlineWait
+**
+** Return the milliseconds until the next execute cycle deadline rounded up,
+** zero if the deadline has been reached.
+*/
+static uint32 ExecuteDeadlineWait(void)
+{
+
+   OS_time_t Now;
+   int64     WaitUsec;
+
+   CFE_PSP_GetTime(&Now);
+   WaitUsec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Bc42Intf.ExecuteDeadline, Now));
+
+   return (WaitUsec > 0) ? (uint32)((WaitUsec + 999) / 1000) : 0;
+
+} /* End ExecuteDeadlineWait() */
+
+
+/******************************************************************************
+** Function: RunExecuteCycle
+**
+** Start an execute message cycle whose deadline has been reached and advance
+** the deadline by one period.
+**
+** Notes:
+**   1. A cycle that starts a full period or more late is an overrun. The
+**      deadline is moved to the current time so the missed cycles aren't run
+**      back to back.
+**   2. ExecuteDriftUsec saturates at the uint32 limit rather than wrapping,
+**      about 71 minutes of accumulated lateness.
+*/
+static void RunExecuteCycle(void)
+{
+
+   OS_time_t Now;
+   uint32    LateUsec;
+   uint32    PeriodUsec = (uint32)Bc42Intf.ExecuteCycleDelay * 1000;
+
+   CFE_PSP_GetTime(&Now);
+   LateUsec = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, Bc42Intf.ExecuteDeadline));
+
+   Bc42Intf.ExecuteDriftUsec = (LateUsec > (0xFFFFFFFF - Bc42Intf.ExecuteDriftUsec)) ?
+                               0xFFFFFFFF : (Bc42Intf.ExecuteDriftUsec + LateUsec);
+   if (LateUsec > Bc42Intf.ExecuteLateMaxUsec)
+   {
+      Bc42Intf.ExecuteLateMaxUsec = LateUsec;
+   }
+   if (LateUsec >= PeriodUsec)
+   {
+      ++Bc42Intf.ExecuteOverrunCnt;
+      Bc42Intf.ExecuteDeadline = Now;
+   }
+   Bc42Intf.ExecuteDeadline = OS_TimeAdd(Bc42Intf.ExecuteDeadline, OS_TimeFromTotalMilliseconds(Bc42Intf.ExecuteCycleDelay));
+
+   COMM42_ManageExecution();
+
+} /* End RunExecuteCycle() */
+
+
 /******************************************************************************
 ** Function: SendHousekeepingPkt
 **
@@ -480,6 +622,9 @@ static int32 ProcessCmdPipe(void)
 void SendHousekeepingPkt(void)
 {
    
+   int i;
+   int64     WallUsec;
+   OS_time_t Now;
    BC42_INTF_StatusTlm_Payload_t *Payload = &Bc42Intf.StatusTlm.Payload;
 
    /*
@@ -497,8 +642,102 @@ void SendHousekeepingPkt(void)
    Payload->ActuatorCmdMsgCnt = Bc42Intf.Comm42.ActuatorCmdMsgCnt;
    Payload->SensorDataMsgCnt  = Bc42Intf.Comm42.SensorDataMsgCnt;
    Payload->SocketConnected   = Bc42Intf.Comm42.SocketConnected;
+   Payload->WireProtocol      = Bc42Intf.Comm42.Link[0].Wire42.Protocol;
+   Payload->LinkConnected     = 0;
+   for (i=0; i < Bc42Intf.Comm42.LinkCnt; i++)
+   {
+      if (Bc42Intf.Comm42.Link[i].SocketConnected)
+      {
+         Payload->LinkConnected |= (1 << i);
+      }
+   }
+   Payload->ExecuteFreeRun    = Bc42Intf.ExecuteFreeRun;
+   Payload->ExecuteOverrunCnt  = Bc42Intf.ExecuteOverrunCnt;
+   Payload->ExecuteLateMaxUsec = Bc42Intf.ExecuteLateMaxUsec;
+   Payload->ExecuteDriftUsec   = Bc42Intf.ExecuteDriftUsec;
+   Payload->AutoConnect       = Bc42Intf.Comm42.AutoConnect;
+   Payload->ConnectCnt        = Bc42Intf.Comm42.ConnectCnt;
+   Payload->Recording         = Bc42Intf.Comm42.Rec42.FileOpen;
+   Payload->RecordCnt         = Bc42Intf.Comm42.Rec42.RecCnt;
+   Payload->CheckpointSaveCnt    = Bc42Intf.Comm42.Ckpt42.SaveCnt;
+   Payload->CheckpointRestoreCnt = Bc42Intf.Comm42.Ckpt42.RestoreCnt;
+   Payload->BatchSteps        = Bc42Intf.Comm42.BatchSteps;
+   Payload->SensorMask        = Bc42Intf.Comm42.SensorMask;
+   Payload->SensorStallCnt    = Bc42Intf.Comm42.SensorStallCnt;
+   Payload->Transport         = Bc42Intf.Comm42.Transport;
+   Payload->UdpStaleCnt       = 0;
+   Payload->UdpLostCnt        = 0;
+   Payload->UdpResendCnt      = 0;
+   Payload->ActuatorStaleCnt      = 0;
+   Payload->ActuatorSupersededCnt = 0;
+   Payload->ActuatorLenErrCnt     = 0;
+   Payload->CycleLostCnt          = 0;
+   Payload->CycleLateCnt          = 0;
+   Payload->CycleMismatchCnt      = 0;
+   for (i=0; i < Bc42Intf.Comm42.LinkCnt; i++)
+   {
+      Payload->UdpStaleCnt  += Bc42Intf.Comm42.Link[i].Wire42.RxStaleCnt;
+      Payload->UdpLostCnt   += Bc42Intf.Comm42.Link[i].Wire42.RxLostCnt;
+      Payload->UdpResendCnt += Bc42Intf.Comm42.Link[i].Wire42.TxResendCnt;
+      Payload->ActuatorStaleCnt      += Bc42Intf.Comm42.Link[i].ActuatorStaleCnt;
+      Payload->ActuatorSupersededCnt += Bc42Intf.Comm42.Link[i].ActuatorSupersededCnt;
+      Payload->ActuatorLenErrCnt     += Bc42Intf.Comm42.Link[i].ActuatorLenErrCnt;
+      Payload->CycleLostCnt          += Bc42Intf.Comm42.Link[i].CycleLostCnt;
+      Payload->CycleLateCnt          += Bc42Intf.Comm42.Link[i].CycleLateCnt;
+      Payload->CycleMismatchCnt      += Bc42Intf.Comm42.Link[i].CycleMismatchCnt;
+   }
+   
+   /*
+   ** The ratio is measured over the interval since the previous packet. A
+   ** backwards sim time is a 42 restart and reports zero.
+   */
+   CFE_PSP_GetTime(&Now);
+   Payload->SimRate      = Bc42Intf.Comm42.SimRate;
+   Payload->SimTime      = Bc42Intf.Comm42.SimTime;
+   Payload->SimWallRatio = 0.0;
+   if (Bc42Intf.HkSimTimeValid && (Payload->SimTime >= Bc42Intf.HkSimTime))
+   {
+      WallUsec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, Bc42Intf.HkWallTime));
+      if (WallUsec > 0)
+      {
+         Payload->SimWallRatio = (float)((Payload->SimTime - Bc42Intf.HkSimTime)*1000000.0/WallUsec);
+      }
+   }
+   Bc42Intf.HkSimTimeValid = Bc42Intf.Comm42.SimTimeValid;
+   Bc42Intf.HkSimTime      = Payload->SimTime;
+   Bc42Intf.HkWallTime     = Now;
 
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(Bc42Intf.StatusTlm.TelemetryHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(Bc42Intf.StatusTlm.TelemetryHeader), true);
 
 } /* End SendHousekeepingPkt() */
+
+
+/******************************************************************************
+** Function: SendDiagPkt
+**
+*/
+void SendDiagPkt(void)
+{
+   
+   BC42_INTF_DiagTlm_Payload_t *Payload = &Bc42Intf.DiagTlm.Payload;
+   const PERF42_Class_t *Perf42 = &Bc42Intf.Comm42.Perf42;
+
+   memcpy(Payload->LoopHist,       Perf42->Hist[PERF42_LOOP_INTERVAL].Bucket,       sizeof(Payload->LoopHist));
+   memcpy(Payload->ReadHist,       Perf42->Hist[PERF42_PHASE_READ].Bucket,          sizeof(Payload->ReadHist));
+   memcpy(Payload->ProcessHist,    Perf42->Hist[PERF42_PHASE_PROCESS].Bucket,       sizeof(Payload->ProcessHist));
+   memcpy(Payload->TransmitHist,   Perf42->Hist[PERF42_PHASE_TRANSMIT].Bucket,      sizeof(Payload->TransmitHist));
+   memcpy(Payload->ControllerHist, Perf42->Hist[PERF42_PHASE_ACTUATOR_RECV].Bucket, sizeof(Payload->ControllerHist));
+   memcpy(Payload->WriteHist,      Perf42->Hist[PERF42_PHASE_WRITE].Bucket,         sizeof(Payload->WriteHist));
+
+   Payload->LoopCnt      = Perf42->LoopCnt;
+   Payload->LoopMinUsec  = (Perf42->LoopCnt > 0) ? Perf42->LoopMinUsec : 0;
+   Payload->LoopMaxUsec  = Perf42->LoopMaxUsec;
+   Payload->LoopMeanUsec = PERF42_LoopMeanUsec(Perf42);
+   Payload->CycleLatencyUsec    = Bc42Intf.Comm42.Link[0].CycleLatencyUsec;
+   Payload->CycleLatencyMaxUsec = Bc42Intf.Comm42.Link[0].CycleLatencyMaxUsec;
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(Bc42Intf.DiagTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(Bc42Intf.DiagTlm.TelemetryHeader), true);
+
+} /* End SendDiagPkt() */
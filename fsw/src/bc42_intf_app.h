@@ -93,7 +93,6 @@ typedef struct
    
    uint32          PerfId;
    CFE_SB_MsgId_t  CmdMid;
-   CFE_SB_MsgId_t  ActuatorCmdMsgMid;
    CFE_SB_MsgId_t  ExecuteMid;
 
 
@@ -103,15 +102,27 @@ typedef struct
    uint16  ExecuteMsgCycleMin;
    uint16  ExecuteMsgCycleMax;
    
-   uint16  ExecuteCycleDelay;    /* Delays between execution cycles */
+   uint16  ExecuteCycleDelay;    /* Milliseconds between execution cycle start deadlines */
    uint16  ExecuteCycleDelayMin;
    uint16  ExecuteCycleDelayMax;
 
+   OS_time_t  ExecuteDeadline;      /* Start time of the execute message's next cycle */
+   uint16     ExecuteOverrunCnt;    /* Cycles that started a full period late */
+   uint32     ExecuteLateMaxUsec;   /* Largest cycle start lateness */
+   uint32     ExecuteDriftUsec;     /* Accumulated cycle start lateness, saturates */
+
+   bool    ExecuteFreeRun;       /* Cycles start when the previous cycle closes instead of with execute messages */
+
+   bool       HkSimTimeValid;    /* Sim and wall clock times of the previous status packet */
+   double     HkSimTime;
+   OS_time_t  HkWallTime;
+
    
    /*
    ** Telemetry Packets
    */
    BC42_INTF_StatusTlm_t  StatusTlm;
+   BC42_INTF_DiagTlm_t    DiagTlm;
    
    /*
    ** App Objects
@@ -0,0 +1,265 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Save and restore checkpoints of the 42 interface state
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "ckpt42.h"
+
+
+/******************************************************************************
+** Function: CKPT42_Constructor
+**
+*/
+void CKPT42_Constructor(CKPT42_Class_t *Ckpt42)
+{
+
+   CFE_PSP_MemSet((void*)Ckpt42, 0, sizeof(CKPT42_Class_t));
+
+} /* End CKPT42_Constructor() */
+
+
+/******************************************************************************
+** Function: CKPT42_LoadAcVar
+**
+*/
+bool CKPT42_LoadAcVar(const CKPT42_Class_t *Ckpt42, struct AcType *AC)
+{
+
+   int i;
+   const CKPT42_AcState_t *AcState = &Ckpt42->Checkpoint.AcState;
+
+   if ((AC->Nwhl != AcState->WhlCnt) || (AC->Nmtb != AcState->MtbCnt) ||
+       (AcState->WhlCnt > CKPT42_WHL_MAX) || (AcState->MtbCnt > CKPT42_MTB_MAX))
+   {
+      CFE_EVS_SendEvent(CKPT42_ACVAR_EID, CFE_EVS_EventType_ERROR,
+                        "Checkpoint has %d wheels and %d torquers, AcVar has %d and %d",
+                        AcState->WhlCnt, AcState->MtbCnt, (int)AC->Nwhl, (int)AC->Nmtb);
+      return false;
+   }
+
+   AC->Time     = AcState->Time;
+   AC->SunValid = AcState->SunValid;
+   for (i=0; i < 3; i++)
+   {
+      AC->PosN[i] = AcState->PosN[i];
+      AC->VelN[i] = AcState->VelN[i];
+      AC->wbn[i]  = AcState->wbn[i];
+      AC->svb[i]  = AcState->svb[i];
+      AC->bvb[i]  = AcState->bvb[i];
+      AC->Tcmd[i] = AcState->Tcmd[i];
+      AC->Mcmd[i] = AcState->Mcmd[i];
+   }
+   for (i=0; i < 4; i++)
+   {
+      AC->qbn[i] = AcState->qbn[i];
+   }
+   for (i=0; i < AcState->WhlCnt; i++)
+   {
+      AC->Whl[i].H    = AcState->WhlH[i];
+      AC->Whl[i].Tcmd = AcState->WhlTcmd[i];
+   }
+   for (i=0; i < AcState->MtbCnt; i++)
+   {
+      AC->MTB[i].Mcmd = AcState->MtbMcmd[i];
+   }
+   AC->G[0].Cmd.Ang[0] = AcState->SaGcmd;
+
+   return true;
+
+} /* End CKPT42_LoadAcVar() */
+
+
+/******************************************************************************
+** Function: CKPT42_Read
+**
+*/
+bool CKPT42_Read(CKPT42_Class_t *Ckpt42, const char *Filename)
+{
+
+   int32  SysStatus;
+   int32  ReadLen = 0;
+   bool   RetStatus = false;
+   osal_id_t        FileHandle;
+   CFE_FS_Header_t  CfeHdr;
+   CKPT42_FileHdr_t FileHdr;
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      if ((CFE_FS_ReadHeader(&CfeHdr, FileHandle) == sizeof(CFE_FS_Header_t)) &&
+          (OS_read(FileHandle, &FileHdr, sizeof(CKPT42_FileHdr_t)) == sizeof(CKPT42_FileHdr_t)) &&
+          (CfeHdr.SubType         == CKPT42_FILE_SUBTYPE) &&
+          (FileHdr.Version        == CKPT42_FILE_VERSION) &&
+          (FileHdr.CheckpointLen  == sizeof(CKPT42_Checkpoint_t)))
+      {
+         ReadLen = OS_read(FileHandle, &Ckpt42->Checkpoint, sizeof(CKPT42_Checkpoint_t));
+      }
+      OS_close(FileHandle);
+
+      if (ReadLen == sizeof(CKPT42_Checkpoint_t))
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CKPT42_READ_EID, CFE_EVS_EventType_ERROR,
+                           "Checkpoint file %s isn't a compatible checkpoint. Read status=%d",
+                           Filename, ReadLen);
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CKPT42_READ_EID, CFE_EVS_EventType_ERROR,
+                        "Error opening checkpoint file %s. Status=%d", Filename, SysStatus);
+   }
+
+   return RetStatus;
+
+} /* End CKPT42_Read() */
+
+
+/******************************************************************************
+** Function: CKPT42_SaveAcVar
+**
+** Notes:
+**   1. Wheels and torquers beyond the checkpoint's limits aren't saved. The
+**      counts are saved as AcVar's so CKPT42_LoadAcVar() rejects the
+**      checkpoint.
+*/
+void CKPT42_SaveAcVar(CKPT42_Class_t *Ckpt42, const struct AcType *AC)
+{
+
+   int i;
+   CKPT42_AcState_t *AcState = &Ckpt42->Checkpoint.AcState;
+
+   CFE_PSP_MemSet((void*)AcState, 0, sizeof(CKPT42_AcState_t));
+
+   AcState->Time     = AC->Time;
+   AcState->SunValid = AC->SunValid;
+   AcState->WhlCnt   = AC->Nwhl;
+   AcState->MtbCnt   = AC->Nmtb;
+   for (i=0; i < 3; i++)
+   {
+      AcState->PosN[i] = AC->PosN[i];
+      AcState->VelN[i] = AC->VelN[i];
+      AcState->wbn[i]  = AC->wbn[i];
+      AcState->svb[i]  = AC->svb[i];
+      AcState->bvb[i]  = AC->bvb[i];
+      AcState->Tcmd[i] = AC->Tcmd[i];
+      AcState->Mcmd[i] = AC->Mcmd[i];
+   }
+   for (i=0; i < 4; i++)
+   {
+      AcState->qbn[i] = AC->qbn[i];
+   }
+   for (i=0; (i < AC->Nwhl) && (i < CKPT42_WHL_MAX); i++)
+   {
+      AcState->WhlH[i]    = AC->Whl[i].H;
+      AcState->WhlTcmd[i] = AC->Whl[i].Tcmd;
+   }
+   for (i=0; (i < AC->Nmtb) && (i < CKPT42_MTB_MAX); i++)
+   {
+      AcState->MtbMcmd[i] = AC->MTB[i].Mcmd;
+   }
+   AcState->SaGcmd = AC->G[0].Cmd.Ang[0];
+
+   if ((AC->Nwhl > CKPT42_WHL_MAX) || (AC->Nmtb > CKPT42_MTB_MAX))
+   {
+      CFE_EVS_SendEvent(CKPT42_ACVAR_EID, CFE_EVS_EventType_ERROR,
+                        "AcVar's %d wheels and %d torquers exceed the checkpoint limits %d and %d",
+                        (int)AC->Nwhl, (int)AC->Nmtb, CKPT42_WHL_MAX, CKPT42_MTB_MAX);
+   }
+
+} /* End CKPT42_SaveAcVar() */
+
+
+/******************************************************************************
+** Function: CKPT42_Write
+**
+*/
+bool CKPT42_Write(CKPT42_Class_t *Ckpt42, const char *Filename)
+{
+
+   int32  SysStatus;
+   int32  WriteLen = 0;
+   bool   RetStatus = false;
+   char   TmpFilename[OS_MAX_PATH_LEN];
+   osal_id_t        FileHandle;
+   CFE_FS_Header_t  CfeHdr;
+   CKPT42_FileHdr_t FileHdr;
+
+   if ((strlen(Filename) + strlen(CKPT42_TMP_SUFFIX)) >= OS_MAX_PATH_LEN)
+   {
+      CFE_EVS_SendEvent(CKPT42_WRITE_EID, CFE_EVS_EventType_ERROR,
+                        "Checkpoint filename %s is too long for its temporary file", Filename);
+      return false;
+   }
+   strcpy(TmpFilename, Filename);
+   strcat(TmpFilename, CKPT42_TMP_SUFFIX);
+
+   SysStatus = OS_OpenCreate(&FileHandle, TmpFilename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      FileHdr.Version       = CKPT42_FILE_VERSION;
+      FileHdr.CheckpointLen = sizeof(CKPT42_Checkpoint_t);
+
+      CFE_FS_InitHeader(&CfeHdr, "BC42 Interface Checkpoint", CKPT42_FILE_SUBTYPE);
+      if ((CFE_FS_WriteHeader(FileHandle, &CfeHdr) == sizeof(CFE_FS_Header_t)) &&
+          (OS_write(FileHandle, &FileHdr, sizeof(CKPT42_FileHdr_t)) == sizeof(CKPT42_FileHdr_t)))
+      {
+         WriteLen = OS_write(FileHandle, &Ckpt42->Checkpoint, sizeof(CKPT42_Checkpoint_t));
+      }
+      OS_close(FileHandle);
+
+      if (WriteLen == sizeof(CKPT42_Checkpoint_t))
+      {
+         SysStatus = OS_rename(TmpFilename, Filename);
+         RetStatus = (SysStatus == OS_SUCCESS);
+      }
+
+      if (!RetStatus)
+      {
+         OS_remove(TmpFilename);
+         CFE_EVS_SendEvent(CKPT42_WRITE_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing checkpoint file %s. Write status=%d, rename status=%d",
+                           Filename, WriteLen, SysStatus);
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CKPT42_WRITE_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating checkpoint file %s. Status=%d", TmpFilename, SysStatus);
+   }
+
+   return RetStatus;
+
+} /* End CKPT42_Write() */
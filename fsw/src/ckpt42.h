@@ -0,0 +1,210 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Save and restore checkpoints of the 42 interface state
+**
+**  Notes:
+**    1. A checkpoint file is a cFE file header, a CKPT42_FileHdr_t, and one
+**       CKPT42_Checkpoint_t in the processor's native byte order. The file
+**       header's checkpoint length must match this build's checkpoint so a
+**       file can't be restored on a processor with a different layout.
+**    2. A checkpoint is written to a temporary file that is renamed over the
+**       checkpoint file so an interrupted save never leaves a partial file.
+**    3. AcVar's arrays are allocated by BC42_LIB so a checkpoint holds the
+**       AcVar fields by value rather than an image of the structure, which
+**       would carry the saving process's pointers. A restore requires the
+**       same wheel and magnetic torquer counts.
+**    4. The object only moves checkpoints between files and AcVar. COMM42
+**       decides when a checkpoint is taken and applied, see comm42.h.
+**    5. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _ckpt42_
+#define _ckpt42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "bc42.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CKPT42_FILE_VERSION   2   /* 2: Sensor data CycleId */
+#define CKPT42_FILE_SUBTYPE   (CFE_FS_SubType_USER_BASE + 0x44)
+
+#define CKPT42_TMP_SUFFIX     ".tmp"
+
+#define CKPT42_LINK_MAX  4   /* Must be at least COMM42_LINK_MAX */
+#define CKPT42_WHL_MAX   4   /* Must agree with the sensor data message's WhlH */
+#define CKPT42_MTB_MAX   3
+
+/*
+** Event Message IDs
+*/
+
+#define CKPT42_WRITE_EID  (CKPT42_BASE_EID + 0)
+#define CKPT42_READ_EID   (CKPT42_BASE_EID + 1)
+#define CKPT42_ACVAR_EID  (CKPT42_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef enum
+{
+
+   CKPT42_REQUEST_NONE    = 0,
+   CKPT42_REQUEST_SAVE    = 1,
+   CKPT42_REQUEST_RESTORE = 2
+
+} CKPT42_Request_t;
+
+
+/******************************************************************************
+** AcVar fields exchanged with 42 and the AcApp processing functions
+*/
+
+typedef struct
+{
+
+   double  Time;
+   double  PosN[3];
+   double  VelN[3];
+   double  qbn[4];
+   double  wbn[3];
+   double  svb[3];
+   double  bvb[3];
+   int32   SunValid;
+   uint16  WhlCnt;
+   uint16  MtbCnt;
+   double  Tcmd[3];
+   double  Mcmd[3];
+   double  WhlH[CKPT42_WHL_MAX];
+   double  WhlTcmd[CKPT42_WHL_MAX];
+   double  MtbMcmd[CKPT42_MTB_MAX];
+   double  SaGcmd;
+
+} CKPT42_AcState_t;
+
+
+/******************************************************************************
+** Checkpoint file contents, see note 1
+*/
+
+typedef struct
+{
+
+   uint32  ExecuteCycleCnt;
+   uint32  SensorDataMsgCnt;
+   uint32  ActuatorCmdMsgCnt;
+   double  SimTime;
+   uint16  LinkCnt;
+   uint16  SensorMask;
+   uint8   SimTimeValid;
+   uint8   InitCycle;
+   uint8   Spare[2];
+
+   CKPT42_AcState_t  AcState;
+
+   BC42_INTF_SensorDataMsg_Payload_t  SensorData[CKPT42_LINK_MAX];   /* Each link's published sensor data */
+
+} CKPT42_Checkpoint_t;
+
+
+typedef struct
+{
+
+   uint32  Version;
+   uint32  CheckpointLen;   /* sizeof(CKPT42_Checkpoint_t) */
+
+} CKPT42_FileHdr_t;
+
+
+/******************************************************************************
+** CKPT42 Class
+*/
+
+typedef struct
+{
+
+   CKPT42_Request_t  Request;          /* Set when a request is made and cleared when it's served */
+   char              Filename[OS_MAX_PATH_LEN];
+
+   CKPT42_Checkpoint_t  Checkpoint;    /* Checkpoint being saved or restored */
+
+   uint16  SaveCnt;
+   uint16  RestoreCnt;
+
+} CKPT42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CKPT42_Constructor
+**
+*/
+void CKPT42_Constructor(CKPT42_Class_t *Ckpt42);
+
+
+/******************************************************************************
+** Function: CKPT42_LoadAcVar
+**
+** Copy the checkpoint's AcVar fields into AC. Nothing is copied and false is
+** returned if AC's wheel or magnetic torquer count differs from the
+** checkpoint's or exceeds the checkpoint's limit.
+**
+*/
+bool CKPT42_LoadAcVar(const CKPT42_Class_t *Ckpt42, struct AcType *AC);
+
+
+/******************************************************************************
+** Function: CKPT42_Read
+**
+** Read and validate a checkpoint file into the object's checkpoint.
+**
+*/
+bool CKPT42_Read(CKPT42_Class_t *Ckpt42, const char *Filename);
+
+
+/******************************************************************************
+** Function: CKPT42_SaveAcVar
+**
+** Copy AC's fields into the object's checkpoint.
+**
+*/
+void CKPT42_SaveAcVar(CKPT42_Class_t *Ckpt42, const struct AcType *AC);
+
+
+/******************************************************************************
+** Function: CKPT42_Write
+**
+** Write the object's checkpoint to a checkpoint file, see note 2.
+**
+*/
+bool CKPT42_Write(CKPT42_Class_t *Ckpt42, const char *Filename);
+
+
+#endif /* _ckpt42_ */
@@ -56,10 +56,85 @@ extern void WriteToSocket(SOCKET Socket, struct AcType *AC); //~bc~
 static COMM42_Class_t *Comm42 = NULL;
 
 
+
+/* Link configuration parameters indexed by link */
+
+static const uint16 LinkPortCfg[COMM42_LINK_MAX] = 
+{
+   CFG_BC42_SOCKET_PORT,   CFG_BC42_SOCKET_PORT_2,
+   CFG_BC42_SOCKET_PORT_3, CFG_BC42_SOCKET_PORT_4
+};
+
+static const uint16 LinkShmNameCfg[COMM42_LINK_MAX] = 
+{
+   CFG_BC42_SHM_NAME,   CFG_BC42_SHM_NAME_2,
+   CFG_BC42_SHM_NAME_3, CFG_BC42_SHM_NAME_4
+};
+
+static const uint16 LinkSensorTopicCfg[COMM42_LINK_MAX] = 
+{
+   CFG_BC42_INTF_SENSOR_DATA_MSG_TOPICID,   CFG_BC42_INTF_SENSOR_DATA_MSG_2_TOPICID,
+   CFG_BC42_INTF_SENSOR_DATA_MSG_3_TOPICID, CFG_BC42_INTF_SENSOR_DATA_MSG_4_TOPICID
+};
+
+static const uint16 LinkActuatorTopicCfg[COMM42_LINK_MAX] = 
+{
+   CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID,   CFG_BC42_INTF_ACTUATOR_CMD_MSG_2_TOPICID,
+   CFG_BC42_INTF_ACTUATOR_CMD_MSG_3_TOPICID, CFG_BC42_INTF_ACTUATOR_CMD_MSG_4_TOPICID
+};
+
+/* Sensor group configuration parameters indexed by GROUP42_x */
+
+static const uint16 GroupTopicCfg[GROUP42_CNT] = 
+{
+   CFG_BC42_INTF_SENSOR_IMU_MSG_TOPICID,     CFG_BC42_INTF_SENSOR_ATTITUDE_MSG_TOPICID,
+   CFG_BC42_INTF_SENSOR_NAV_MSG_TOPICID,     CFG_BC42_INTF_SENSOR_SUN_MAG_MSG_TOPICID,
+   CFG_BC42_INTF_SENSOR_WHEEL_MSG_TOPICID
+};
+
+static const uint16 GroupDecimCfg[GROUP42_CNT] = 
+{
+   CFG_BC42_GROUP_IMU_DECIM, CFG_BC42_GROUP_ATTITUDE_DECIM, CFG_BC42_GROUP_NAV_DECIM,
+   CFG_BC42_GROUP_SUN_MAG_DECIM, CFG_BC42_GROUP_WHEEL_DECIM
+};
+
+
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
+static void AbortSensorRecv(COMM42_Link_t *Link);
+static void AcVarToSensorFrame(WIRE42_SensorFrame_t *SensorFrame);
+static bool AllActuatorCmdsSent(void);
+static void AcceptCycleTag(COMM42_Link_t *Link, const BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmd);
+static bool CheckCycleTag(COMM42_Link_t *Link, const BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmd);
+static COMM42_Transport_t CheckTransport(COMM42_Transport_t Transport);
+static void CloseLink(COMM42_Link_t *Link);
+static void CloseLinks(void);
+static bool ConnectLink(COMM42_Link_t *Link, const char *AddrStr, uint32 Port);
+static uint32 ConnectWaitMsec(void);
+static bool CycleBoundary(void);
+static bool ActuatorCmdWait(void);
+static void LoadSensorData(BC42_INTF_SensorDataMsg_Payload_t *SensorData,
+                           const WIRE42_SensorFrame_t *SensorFrame);
+static void ManageConnections(void);
+static void MarkPhase(const COMM42_Link_t *Link, PERF42_Phase_t Phase);
+static bool OpenShm(COMM42_Link_t *Link);
+static bool OpenSocket(COMM42_Link_t *Link, const char *AddrStr, uint32 Port);
+static int32 ReadSensorFrame(COMM42_Link_t *Link, WIRE42_SensorFrame_t *SensorFrame);
+static int32 RecvActuatorCmds(void);
+static void RecvLinkSensorData(COMM42_Link_t *Link, bool Prefetch);
+static void RecvSensorData(bool Prefetch);
+static int64 ResendActuatorFrame(COMM42_Link_t *Link, OS_time_t Now);
+static void SendActuatorFrame(COMM42_Link_t *Link, const WIRE42_ActuatorFrame_t *ActuatorFrame);
+static void SendSensorDataMsg(COMM42_Link_t *Link);
+static void SensorFrameToAcVar(const WIRE42_SensorFrame_t *SensorFrame);
+static void ServiceCheckpoint(void);
+static void ServiceRequests(void);
+static uint32 SimPaceWaitMsec(void);
+static void StartSensorRecv(COMM42_Link_t *Link);
+static void UpdateSimTime(double SimTime);
+
 
 /******************************************************************************
 ** Function: COMM42_Constructor
@@ -73,11 +148,23 @@ static COMM42_Class_t *Comm42 = NULL;
 **   3. Socket configuration parameters from the JSON init file are
 **      are saved but a socket connection is not attempted. A socket 
 **      is performed in response to a connect command.
+**   4. The sensor data message is double buffered so a prefetch can receive
+**      the next cycle's data without disturbing the published message.
+**   5. Links after the first can't be mirrored in AcVar so they require the
+**      binary protocol. Only the first link is used if the binary protocol
+**      isn't configured.
+**   6. The shared memory transport requires the binary protocol. The socket
+**      transport is used if the binary protocol isn't configured.
 */
 void COMM42_Constructor(COMM42_Class_t *Comm42Obj, const INITBL_Class_t *IniTbl)
 {
 
    int32 CfeStatus;
+   int   i, j;
+   COMM42_Link_t *Link;
+   CFE_SB_MsgId_t GroupMsgId[GROUP42_CNT];
+   uint16         GroupDecim[GROUP42_CNT];
+   CFE_SB_Qos_t   SbQos;
 
    Comm42 = Comm42Obj;
 
@@ -87,9 +174,145 @@ void COMM42_Constructor(COMM42_Class_t *Comm42Obj, const INITBL_Class_t *IniTbl)
    Comm42->SocketConnected = false;
    Comm42->UnclosedCycleLim = INITBL_GetIntConfig(IniTbl, CFG_EXE_UNCLOSED_CYCLE_LIM);
 
-   CFE_MSG_Init(CFE_MSG_PTR(Comm42->SensorDataMsg.TelemetryHeader), 
-                CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_INTF_SENSOR_DATA_MSG_TOPICID)),
-                sizeof(BC42_INTF_SensorDataMsg_t));
+   Comm42->WireProtocolCfg  = WIRE42_ParseProtocol(INITBL_GetStrConfig(IniTbl, CFG_BC42_WIRE_PROTOCOL));
+   Comm42->WireHelloTimeout = INITBL_GetIntConfig(IniTbl, CFG_BC42_WIRE_HELLO_TIMEOUT);
+   
+   Comm42->TransportCfg = COMM42_TRANSPORT_SOCKET;
+   if (strcmp(INITBL_GetStrConfig(IniTbl, CFG_BC42_TRANSPORT), COMM42_TRANSPORT_SHM_STR) == 0)
+   {
+      Comm42->TransportCfg = CheckTransport(COMM42_TRANSPORT_SHM);
+   }
+   else if (strcmp(INITBL_GetStrConfig(IniTbl, CFG_BC42_TRANSPORT), COMM42_TRANSPORT_UDP_STR) == 0)
+   {
+      Comm42->TransportCfg = CheckTransport(COMM42_TRANSPORT_UDP);
+   }
+   Comm42->Transport        = Comm42->TransportCfg;
+   Comm42->UdpResendTimeout = INITBL_GetIntConfig(IniTbl, CFG_BC42_UDP_RESEND_TIMEOUT);
+   
+   Comm42->ConnectTimeout    = INITBL_GetIntConfig(IniTbl, CFG_BC42_CONNECT_TIMEOUT);
+   Comm42->ConnectBackoffMin = INITBL_GetIntConfig(IniTbl, CFG_BC42_CONNECT_BACKOFF_MIN);
+   Comm42->ConnectBackoffMax = INITBL_GetIntConfig(IniTbl, CFG_BC42_CONNECT_BACKOFF_MAX);
+   PERF42_Constructor(&Comm42->Perf42);
+   TRACE42_Constructor(&Comm42->Trace42);
+   strncpy(Comm42->TraceFile, INITBL_GetStrConfig(IniTbl, CFG_TRACE_FILE), OS_MAX_PATH_LEN);
+   Comm42->TraceFile[OS_MAX_PATH_LEN-1] = '\0';
+   REC42_Constructor(&Comm42->Rec42);
+   strncpy(Comm42->RecordFile, INITBL_GetStrConfig(IniTbl, CFG_RECORD_FILE), OS_MAX_PATH_LEN);
+   Comm42->RecordFile[OS_MAX_PATH_LEN-1] = '\0';
+   CKPT42_Constructor(&Comm42->Ckpt42);
+   strncpy(Comm42->CheckpointFile, INITBL_GetStrConfig(IniTbl, CFG_CHECKPOINT_FILE), OS_MAX_PATH_LEN);
+   Comm42->CheckpointFile[OS_MAX_PATH_LEN-1] = '\0';
+
+   Comm42->SensorPrefetch = (INITBL_GetIntConfig(IniTbl, CFG_EXE_SENSOR_PREFETCH) != 0);
+   Comm42->SimRate        = INITBL_GetIntConfig(IniTbl, CFG_EXE_SIM_RATE_DEF);
+   Comm42->SimTickPeriod  = INITBL_GetIntConfig(IniTbl, CFG_BC42_SIM_TICK_PERIOD);
+   CFE_MSG_Init(CFE_MSG_PTR(Comm42->SimTickMsg.TelemetryHeader), 
+                CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_INTF_SIM_TICK_MSG_TOPICID)),
+                sizeof(BC42_INTF_SimTickMsg_t));
+
+   Comm42->LinkCnt = INITBL_GetIntConfig(IniTbl, CFG_BC42_LINK_CNT);
+   if ((Comm42->LinkCnt < 1) || (Comm42->LinkCnt > COMM42_LINK_MAX))
+   {
+      CFE_EVS_SendEvent(COMM42_LINK_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid link count %d, must be between 1 and %d. Using 1 link", 
+                        Comm42->LinkCnt, COMM42_LINK_MAX);
+      Comm42->LinkCnt = 1;
+   }
+   else if ((Comm42->LinkCnt > 1) && (Comm42->WireProtocolCfg != WIRE42_PROTOCOL_BINARY))
+   {
+      CFE_EVS_SendEvent(COMM42_LINK_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                        "%d links configured without the %s wire protocol. Using 1 link", 
+                        Comm42->LinkCnt, WIRE42_PROTOCOL_BINARY_STR);
+      Comm42->LinkCnt = 1;
+   }
+   
+   Comm42->BatchSteps = INITBL_GetIntConfig(IniTbl, CFG_BC42_BATCH_STEPS);
+   if ((Comm42->BatchSteps < 1) || (Comm42->BatchSteps > WIRE42_BATCH_MAX))
+   {
+      CFE_EVS_SendEvent(COMM42_BATCH_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid batch steps %d, must be between 1 and %d. Using 1 step", 
+                        Comm42->BatchSteps, WIRE42_BATCH_MAX);
+      Comm42->BatchSteps = 1;
+   }
+   else if ((Comm42->BatchSteps > 1) && (Comm42->WireProtocolCfg != WIRE42_PROTOCOL_BINARY))
+   {
+      CFE_EVS_SendEvent(COMM42_BATCH_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                        "%d batch steps configured without the %s wire protocol. Using 1 step", 
+                        Comm42->BatchSteps, WIRE42_PROTOCOL_BINARY_STR);
+      Comm42->BatchSteps = 1;
+   }
+   
+   Comm42->SensorMask = INITBL_GetIntConfig(IniTbl, CFG_BC42_SENSOR_MASK);
+   if ((Comm42->SensorMask & ~WIRE42_SENSOR_ALL) != 0)
+   {
+      CFE_EVS_SendEvent(COMM42_SENSOR_MASK_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid sensor mask 0x%04X, undefined bits in 0x%04X are ignored", 
+                        Comm42->SensorMask, (uint16)~WIRE42_SENSOR_ALL);
+      Comm42->SensorMask &= WIRE42_SENSOR_ALL;
+   }
+   
+   if ((Comm42->BatchSteps > 1) && Comm42->SensorPrefetch)
+   {
+      CFE_EVS_SendEvent(COMM42_BATCH_CONFIG_EID, CFE_EVS_EventType_INFORMATION,
+                        "Sensor prefetch disabled, it isn't used with %d step batches", Comm42->BatchSteps);
+      Comm42->SensorPrefetch = false;
+   }
+   
+   for (i=0; i < GROUP42_CNT; i++)
+   {
+      GroupMsgId[i] = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, GroupTopicCfg[i]));
+      GroupDecim[i] = INITBL_GetIntConfig(IniTbl, GroupDecimCfg[i]);
+   }
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      
+      Link = &Comm42->Link[i];
+      
+      Link->Index = i;
+      Link->Port  = INITBL_GetIntConfig(IniTbl, LinkPortCfg[i]);
+      strncpy(Link->ShmName, INITBL_GetStrConfig(IniTbl, LinkShmNameCfg[i]), SHM42_NAME_LEN);
+      Link->ShmName[SHM42_NAME_LEN-1] = '\0';
+      SHM42_Constructor(&Link->Shm42);
+      Link->ActuatorCmdMsgMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, LinkActuatorTopicCfg[i]));
+      
+      WIRE42_Constructor(&Link->Wire42);
+      Link->Wire42.SensorMask = Comm42->SensorMask;
+      REC42_Constructor(&Link->Replay42);
+      DELTA42_Constructor(&Link->Delta42, (INITBL_GetIntConfig(IniTbl, CFG_BC42_DELTA_MSG_ENA) != 0),
+                          CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_INTF_SENSOR_DELTA_MSG_TOPICID)),
+                          i, INITBL_GetIntConfig(IniTbl, CFG_BC42_DELTA_MSG_KEYFRAME));
+      GROUP42_Constructor(&Link->Group42, i, GroupMsgId, GroupDecim);
+      
+      for (j=0; j < COMM42_SENSOR_BUF_CNT; j++)
+      {
+         CFE_MSG_Init(CFE_MSG_PTR(Link->SensorDataMsg[j].TelemetryHeader), 
+                      CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, LinkSensorTopicCfg[i])),
+                      sizeof(BC42_INTF_SensorDataMsg_t));
+      }
+   } /* End link loop */
+   
+   Comm42->ActuatorPipeTimeout = INITBL_GetIntConfig(IniTbl, CFG_APP_ACT_PIPE_TIMEOUT);
+   Comm42->ChildWaitTimeout    = INITBL_GetIntConfig(IniTbl, CFG_BC42_CHILD_WAIT_TIMEOUT);
+   Comm42->SensorTimeout       = INITBL_GetIntConfig(IniTbl, CFG_BC42_SENSOR_TIMEOUT);
+   CfeStatus = CFE_SB_CreatePipe(&Comm42->ActuatorPipe, INITBL_GetIntConfig(IniTbl, CFG_APP_ACT_PIPE_DEPTH),
+                                 INITBL_GetStrConfig(IniTbl, CFG_APP_ACT_PIPE_NAME));
+   if (CfeStatus == CFE_SUCCESS)
+   {
+      SbQos.Priority    = 0;
+      SbQos.Reliability = 0;
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         CFE_SB_SubscribeEx(Comm42->Link[i].ActuatorCmdMsgMid, Comm42->ActuatorPipe, SbQos,
+                            INITBL_GetIntConfig(IniTbl, CFG_APP_CMD_PIPE_ACT_MSG_LIM));
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(COMM42_ACTUATOR_PIPE_EID, CFE_EVS_EventType_ERROR,
+                        "Failed to create %s actuator pipe. Status=0x%8X", 
+                        INITBL_GetStrConfig(IniTbl, CFG_APP_ACT_PIPE_NAME), (int)CfeStatus);
+   }
    
    /* Create semaphore (given by parent to wake-up child) */
    CfeStatus = OS_BinSemCreate(&Comm42->WakeUpSemaphore, INITBL_GetStrConfig(IniTbl, CFG_CHILD_SEM_NAME), OS_SEM_EMPTY, 0);
@@ -109,83 +332,87 @@ void COMM42_Constructor(COMM42_Class_t *Comm42Obj, const INITBL_Class_t *IniTbl)
 /******************************************************************************
 ** Function: COMM42_Close
 **
+** Notes:
+**   1. Pending connect and replay requests are cancelled so the last command
+**      wins.
 */
 void COMM42_Close(void)
 {
 
-   if (Comm42->SocketConnected == true)
-   {
-    
-      OS_close(Comm42->SocketId);
+   Comm42->ConnectRequest = false;
+   Comm42->ReplayRequest  = false;
+   Comm42->CloseRequest   = true;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
+
+} /* End COMM42_Close() */
+
+
+/******************************************************************************
+** Function:  COMM42_ConnectSocket
+**
+** Notes:
+**   1. The child task attempts the connections after it serves the request
+**      and the first cycle is started when the first link connects.
+*/
+void COMM42_ConnectSocket(const char *AddrStr, uint32 Port, COMM42_Transport_t Transport)
+{
+   
+   strncpy(Comm42->ConnectAddrStr, AddrStr, sizeof(Comm42->ConnectAddrStr));
+   Comm42->ConnectAddrStr[sizeof(Comm42->ConnectAddrStr)-1] = '\0';
+   Comm42->ConnectPort      = Port;
+   Comm42->ConnectTransport = CheckTransport(Transport);
    
-      Comm42->SocketConnected = false;
+   Comm42->ConnectRequest = true;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
       
-      CFE_EVS_SendEvent(COMM42_SOCKET_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
-                        "Successfully closed socket");
+} /* End COMM42_ConnectSocket() */
 
-  
-   } /* End if connected */
+
+/******************************************************************************
+** Function: COMM42_DumpTraceCmd
+**
+*/
+bool COMM42_DumpTraceCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const BC42_INTF_DumpTraceCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_DumpTraceCmd_t);
+   char Filename[OS_MAX_PATH_LEN];
+   
+   if (Cmd->Filename[0] == '\0')
+   {
+      strncpy(Filename, Comm42->TraceFile, OS_MAX_PATH_LEN);
+   }
    else
    {
-      CFE_EVS_SendEvent(COMM42_SOCKET_CLOSE_EID, CFE_EVS_EventType_DEBUG,
-                        "Attempt to close socket without a connection");
+      strncpy(Filename, Cmd->Filename, OS_MAX_PATH_LEN);
    }
-
-   Comm42->ActuatorCmdMsgSent = false;
-   COMM42_ResetStatus();
-
-} /* End COMM42_Close() */
+   Filename[OS_MAX_PATH_LEN-1] = '\0';
+   
+   return TRACE42_Dump(&Comm42->Trace42, Filename);
+   
+} /* End COMM42_DumpTraceCmd() */
 
 
 /******************************************************************************
-** Function:  COMM42_ConnectSocket
+** Function: COMM42_GetActuatorCmdLink
 **
 */
-bool COMM42_ConnectSocket(const char *AddrStr, uint32 Port)
+uint16 COMM42_GetActuatorCmdLink(CFE_SB_MsgId_t MsgId)
 {
-   int32 Status;
    
-   Comm42->SocketConnected = false;
+   uint16 i;
    
-   Status = OS_SocketOpen(&Comm42->SocketId, OS_SocketDomain_INET, OS_SocketType_STREAM);
-   if (Status == OS_SUCCESS)
+   for (i=0; i < Comm42->LinkCnt; i++)
    {
-      
-      CFE_EVS_SendEvent(COMM42_SOCKET_OPEN_EID, CFE_EVS_EventType_INFORMATION, 
-                        "Successfully opened socket, ID = %d", (int)Comm42->SocketId);
-
-      OS_SocketAddrInit(&Comm42->SocketAddr, OS_SocketDomain_INET);
-      OS_SocketAddrFromString(&Comm42->SocketAddr, AddrStr);   
-      OS_SocketAddrSetPort(&Comm42->SocketAddr, Port);
-   
-      Status = OS_SocketConnect(Comm42->SocketId, &Comm42->SocketAddr, 2000);
-      if (Status == OS_SUCCESS)
-      {
-         Comm42->InitCycle = true;
-         Comm42->SocketConnected = true;
-         CFE_EVS_SendEvent(COMM42_SOCKET_CONNECT_EID, CFE_EVS_EventType_INFORMATION, 
-                           "Successfully connected to socket address %s, listening on port %d",
-                           AddrStr, (int)Port);
-         
-      }
-      else
+      if (CFE_SB_MsgId_Equal(MsgId, Comm42->Link[i].ActuatorCmdMsgMid))
       {
-         CFE_EVS_SendEvent(COMM42_SOCKET_CONNECT_EID, CFE_EVS_EventType_ERROR, 
-                           "Error connecting to socket address %s, OS_SocketBind() return code = %d", 
-                           AddrStr, (int)Status);
+         return i;
       }
-   } /* End if open */
-   else
-   {
-      CFE_EVS_SendEvent(COMM42_SOCKET_OPEN_EID, CFE_EVS_EventType_ERROR, 
-                        "Error opening socket. OS_SocketOpen() return code = %d", (int)Status);
    }
    
-   OS_BinSemGive(Comm42->WakeUpSemaphore); //TODO: Need to think through this
+   return COMM42_LINK_UNDEF;
    
-   return Comm42->SocketConnected;
-      
-} /* End COMM42_ConnectSocket() */
+} /* End COMM42_GetActuatorCmdLink() */
 
 
 /******************************************************************************
@@ -200,13 +427,21 @@ bool COMM42_ConnectSocket(const char *AddrStr, uint32 Port)
 **   3. The WakeUpSemaphore can become invalid when the child task is
 **      intentionally terminated in a disconnect scenario so don't take any
 **      action. 
+**   4. CyclePending lets the child task distinguish a cycle start from a
+**      prefetch or actuator write request when they are given before the
+**      child runs.
+**   5. When free running COMM42_SendActuatorCmds() starts each cycle so this
+**      function only verifies the cycles are progressing. A closed cycle
+**      without progress occurs when free running is first enabled and an
+**      unclosed cycle without progress uses the same limit logic as a paced
+**      cycle.
 */
 void COMM42_ManageExecution(void)
 {
 
-   CFE_EVS_SendEvent(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG, 
-                     "*** COMM42_App::ManageExecution(%d): WakeUpSemaphore=%08X, ActuatorPktSent=%d",
-                     Comm42->ExecuteCycleCnt, Comm42->WakeUpSemaphore, Comm42->ActuatorCmdMsgSent);
+   BC42_INTF_CYCLE_EVENT(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG, 
+                         "*** COMM42_App::ManageExecution(%d): WakeUpSemaphore=%08X, ActuatorPktSent=%d",
+                         Comm42->ExecuteCycleCnt, Comm42->WakeUpSemaphore, Comm42->ActuatorCmdMsgSent);
    
    if (Comm42->SocketConnected)
    {
@@ -223,13 +458,22 @@ void COMM42_ManageExecution(void)
       if (Comm42->WakeUpSemaphore != COMM42_SEM_INVALID)  // TODO: Not currently being set
       { 
          
-         if (Comm42->ActuatorCmdMsgSent == true)
+         if (Comm42->FreeRun && (Comm42->ExecuteCycleCnt != Comm42->FreeRunCycleCnt))
+         {
+            
+            Comm42->UnclosedCycleCnt = 0;
+         
+         }
+         else if (Comm42->ActuatorCmdMsgSent == true)
          {
          
-            CFE_EVS_SendEvent(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
-                              "**** COMM42_ManageExecution(): Giving semaphore - WakeUpSemaphore=%08X, ActuatorPktSent=%d",
-                              Comm42->WakeUpSemaphore,Comm42->ActuatorCmdMsgSent);
+            BC42_INTF_CYCLE_EVENT(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
+                                  "**** COMM42_ManageExecution(): Giving semaphore - WakeUpSemaphore=%08X, ActuatorPktSent=%d",
+                                  Comm42->WakeUpSemaphore,Comm42->ActuatorCmdMsgSent);
             
+            TRACE42_Record(&Comm42->Trace42, COMM42_TRACE_CYCLE_START, Comm42->ExecuteCycleCnt,
+                           Comm42->UnclosedCycleCnt, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt);
+            Comm42->CyclePending = true;
             OS_BinSemGive(Comm42->WakeUpSemaphore);
             Comm42->UnclosedCycleCnt = 0;
          
@@ -238,6 +482,8 @@ void COMM42_ManageExecution(void)
          {
             
             ++Comm42->UnclosedCycleCnt;
+            TRACE42_Record(&Comm42->Trace42, COMM42_TRACE_UNCLOSED, Comm42->ExecuteCycleCnt,
+                           Comm42->UnclosedCycleCnt, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt);
             if (Comm42->UnclosedCycleCnt > Comm42->UnclosedCycleLim)
             {
          
@@ -246,11 +492,15 @@ void COMM42_ManageExecution(void)
                                  "Actuator command not received for %d execution cycles. Giving child semaphore",
                                  Comm42->UnclosedCycleCnt);
 
+               Comm42->CyclePending = true;
                OS_BinSemGive(Comm42->WakeUpSemaphore); 
                Comm42->UnclosedCycleCnt = 0;
             
             }/* End if unclosed cycle */
          } /* End if no actuator packet */
+         
+         Comm42->FreeRunCycleCnt = Comm42->ExecuteCycleCnt;
+         
       } /* End if semaphore valid */
        
    } /* End if connected */
@@ -262,71 +512,6 @@ void COMM42_ManageExecution(void)
 } /* COMM42_ManageExecution() */
 
 
-/******************************************************************************
-** Function: COMM42_RecvSensorData
-**
-*/
-bool COMM42_RecvSensorData(BC42_INTF_SensorDataMsg_t *SensorDataMsg)
-{
-
-   int   i, NumBytesRead;
-   bool  RetStatus = false;
-   
-   BC42_INTF_SensorDataMsg_Payload_t *SensorData = &SensorDataMsg->Payload;
-   
-   CFE_EVS_SendEvent(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
-                     "**** COMM42_RecvSensorData(): ExecCnt=%d, SensorCnt=%d, ActuatorCnt=%d, ActuatorSent=%d",
-                     Comm42->ExecuteCycleCnt, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt, Comm42->ActuatorCmdMsgSent);
-
-   Comm42->Bc42 = BC42_TakePtr();
-   AC42_(EchoEnabled) = false;
-
-   NumBytesRead = BC42_ReadFromSocket(Comm42->SocketId, &Comm42->SocketAddr, &Comm42->Bc42->AcVar);
-   
-   if (NumBytesRead > 0)
-   {
-      GyroProcessing(AC42);
-      MagnetometerProcessing(AC42);
-      CssProcessing(AC42);
-      FssProcessing(AC42);
-      StarTrackerProcessing(AC42);
-      GpsProcessing(AC42);
-      
-      SensorData->GpsTime = AC42_(Time); 
-      SensorData->GpsValid  = true;
-      SensorData->StValid   = true;
-      SensorData->SunValid  = AC42_(SunValid);
-      SensorData->InitCycle = Comm42->InitCycle;
-
-      for (i=0; i < 3; i++) {
-      
-         SensorData->PosN[i] = AC42_(PosN[i]);  /* GPS */
-         SensorData->VelN[i] = AC42_(VelN[i]);
-      
-         SensorData->qbn[i]  = AC42_(qbn[i]);   /* ST */
-
-         SensorData->wbn[i]  = AC42_(wbn[i]);   /* Gyro */
-      
-         SensorData->svb[i]  = AC42_(svb[i]);   /* CSS/FSS */
-
-         SensorData->bvb[i]  = AC42_(bvb[i]);   /* MTB */
-      
-         SensorData->WhlH[i] = AC42_(Whl[i].H); /* Wheels */
-      }
-
-      SensorData->qbn[3]  = AC42_(qbn[3]);
-      SensorData->WhlH[3] = AC42_(Whl[3].H);
-      
-      RetStatus = true;
-   }
-
-   BC42_GivePtr(Comm42->Bc42);
-
-   return RetStatus;
-
-} /* COMM42_RecvSensorData() */
-
-
 /******************************************************************************
 ** Function:  COMM42_ResetStatus
 **
@@ -337,134 +522,2108 @@ bool COMM42_RecvSensorData(BC42_INTF_SensorDataMsg_t *SensorDataMsg)
 void COMM42_ResetStatus(void)
 {
 
+   int i;
+   
    Comm42->ExecuteCycleCnt   = 0;
    Comm42->SensorDataMsgCnt  = 0;
    Comm42->ActuatorCmdMsgCnt = 0;
    Comm42->UnclosedCycleCnt  = 0;
+   Comm42->ConnectCnt        = 0;
+   Comm42->SensorStallCnt    = 0;
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      Comm42->Link[i].SensorStallCnt = 0;
+      Comm42->Link[i].ActuatorStaleCnt      = 0;
+      Comm42->Link[i].ActuatorSupersededCnt = 0;
+      Comm42->Link[i].ActuatorLenErrCnt     = 0;
+      Comm42->Link[i].CycleLostCnt          = 0;
+      Comm42->Link[i].CycleLateCnt          = 0;
+      Comm42->Link[i].CycleMismatchCnt      = 0;
+      Comm42->Link[i].CycleLatencyMaxUsec   = 0;
+      WIRE42_ResetStatus(&Comm42->Link[i].Wire42);
+   }
+   Comm42->PerfResetRequest = true;   /* The child makes every PERF42 mark so it resets PERF42 */
   
 } /* End COMM42_ResetStatus() */
 
 
 /******************************************************************************
-** Function: COMM42_SendActuatorCmds
+** Function: COMM42_RestoreCheckpointCmd
 **
+** Notes:
+**   1. The child doesn't access the checkpoint while no request is pending so
+**      the file can be read into it here. The request is set last.
 */
-bool COMM42_SendActuatorCmds(const BC42_INTF_ActuatorCmdMsg_t *ActuatorCmdMsg) 
+bool COMM42_RestoreCheckpointCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
-
-   int i;
-   const BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmd = &ActuatorCmdMsg->Payload;
    
-
-   CFE_EVS_SendEvent(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
-                     "**** COMM42_SendActuatorCmds(): ExeCnt=%d, SnrCnt=%d, ActCnt=%d, ActSent=%d",
-                     Comm42->ExecuteCycleCnt, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt, Comm42->ActuatorCmdMsgSent);
+   const BC42_INTF_RestoreCheckpointCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_RestoreCheckpointCmd_t);
+   CKPT42_Class_t *Ckpt42 = &Comm42->Ckpt42;
    
-   Comm42->Bc42 = BC42_TakePtr();
-
-   for (i=0; i < 3; i++) 
+   if (Ckpt42->Request != CKPT42_REQUEST_NONE)
    {
-      AC42_(Tcmd[i]) = ActuatorCmd->Tcmd[i];
-      AC42_(Mcmd[i]) = ActuatorCmd->Mcmd[i];
+      CFE_EVS_SendEvent(COMM42_CHECKPOINT_EID, CFE_EVS_EventType_ERROR,
+                        "Restore checkpoint command rejected, a checkpoint request is pending");
+      return false;
    }
    
-   AC42_(G[0].Cmd.Ang[0]) = ActuatorCmd->SaGcmd;
-
-   WheelProcessing(AC42);
-   MtbProcessing(AC42);
+   strncpy(Ckpt42->Filename, (Cmd->Filename[0] == '\0') ? Comm42->CheckpointFile : Cmd->Filename, OS_MAX_PATH_LEN);
+   Ckpt42->Filename[OS_MAX_PATH_LEN-1] = '\0';
    
-   BC42_WriteToSocket(Comm42->SocketId, &Comm42->SocketAddr, AC42);
+   if (!CKPT42_Read(Ckpt42, Ckpt42->Filename))
+   {
+      return false;
+   }
+   
+   if (Ckpt42->Checkpoint.LinkCnt != Comm42->LinkCnt)
+   {
+      CFE_EVS_SendEvent(COMM42_CHECKPOINT_EID, CFE_EVS_EventType_ERROR,
+                        "Restore checkpoint command rejected, %s has %d links and %d are configured",
+                        Ckpt42->Filename, Ckpt42->Checkpoint.LinkCnt, Comm42->LinkCnt);
+      return false;
+   }
    
-   BC42_GivePtr(Comm42->Bc42);
+   Ckpt42->Request = CKPT42_REQUEST_RESTORE;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
    
-   Comm42->InitCycle = false;
-   ++Comm42->ActuatorCmdMsgCnt;
-   Comm42->ActuatorCmdMsgSent = true;
-      
    return true;
-
-} /* End COMM42_SendActuatorCmds() */
+   
+} /* End COMM42_RestoreCheckpointCmd() */
 
 
 /******************************************************************************
-** Function: COMM42_Shutdown
+** Function: COMM42_SaveCheckpointCmd
 **
-** Close the socket and force a child task exit. The sequence of this code must
-** work with the COMM42_SocketTask() logic to avoid strange. 
-** 
 */
-void COMM42_Shutdown(void)
+bool COMM42_SaveCheckpointCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
    
-   COMM42_Close();
-   Comm42->ChildTaskRun = false;
+   const BC42_INTF_SaveCheckpointCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_SaveCheckpointCmd_t);
+   CKPT42_Class_t *Ckpt42 = &Comm42->Ckpt42;
+   
+   if (Ckpt42->Request != CKPT42_REQUEST_NONE)
+   {
+      CFE_EVS_SendEvent(COMM42_CHECKPOINT_EID, CFE_EVS_EventType_ERROR,
+                        "Save checkpoint command rejected, a checkpoint request is pending");
+      return false;
+   }
+   
+   strncpy(Ckpt42->Filename, (Cmd->Filename[0] == '\0') ? Comm42->CheckpointFile : Cmd->Filename, OS_MAX_PATH_LEN);
+   Ckpt42->Filename[OS_MAX_PATH_LEN-1] = '\0';
+   
+   Ckpt42->Request = CKPT42_REQUEST_SAVE;
    OS_BinSemGive(Comm42->WakeUpSemaphore);
    
-} /* End COMM42_Shutdown() */
+   return true;
+   
+} /* End COMM42_SaveCheckpointCmd() */
 
 
 /******************************************************************************
-** Function: COMM42_SocketTask
+** Function: COMM42_SendActuatorCmds
 **
 ** Notes:
-**   1. This function is continuously called by the app_c_fw's ChildMgr
-**      service. Returning false causes the child task to terminate.
-**   2. This infinite loop design proved to be the most robust. I tried to 
-**      create/terminate the child task with a socket connect/disconnect and
-**      something didn't seem to get cleaned up properly and the system would
-**      hang on a second connect cmd. 
-**
+**   1. Only the first link is mirrored in AcVar. Its sensor snapshots are
+**      copied into AcVar when they're read, so the lock is only held here to
+**      copy the actuator command.
+**   2. The cycle is closed when every connected link has sent its actuator
+**      command. A batched link sends an actuator command for each sensor
+**      data message of the exchange.
+**   3. A rejected tagged command leaves the link waiting for its actuator
+**      command.
 */
-bool COMM42_SocketTask(CHILDMGR_Class_t* ChildMgr)
+bool COMM42_SendActuatorCmds(uint16 LinkIndex, const BC42_INTF_ActuatorCmdMsg_t *ActuatorCmdMsg) 
 {
-      
-   int32 CfeStatus;
+
+   int  i;
+   bool LinkCycleClosed;
+   const BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmd = &ActuatorCmdMsg->Payload;
+   COMM42_Link_t          *Link = &Comm42->Link[LinkIndex];
+   WIRE42_ActuatorFrame_t ActuatorFrame;
    
-   if (Comm42->SocketConnected)
+   if (!CheckCycleTag(Link, ActuatorCmd))
+   {
+      return false;
+   }
+   AcceptCycleTag(Link, ActuatorCmd);
+   
+   MarkPhase(Link, PERF42_PHASE_ACTUATOR_RECV);
+
+   /* Must be evaluated before the batch write changes ExchangeSteps */
+   LinkCycleClosed = (++Link->ActuatorStepCnt >= Link->ExchangeSteps);
+   if (LinkCycleClosed)
+   {
+      Link->ActuatorStepCnt = 0;
+      Link->ActuatorCmdWait = false;
+   }
+   
+   BC42_INTF_CYCLE_EVENT(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
+                         "**** COMM42_SendActuatorCmds(%d): ExeCnt=%d, SnrCnt=%d, ActCnt=%d, ActSent=%d",
+                         LinkIndex, Comm42->ExecuteCycleCnt, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt, Link->ActuatorCmdMsgSent);
+   
+   /* 42 distributes the body frame commands to the individual actuators */
+   for (i=0; i < 3; i++) 
+   {
+      ActuatorFrame.Tcmd[i] = ActuatorCmd->Tcmd[i];
+      ActuatorFrame.Mcmd[i] = ActuatorCmd->Mcmd[i];
+   }
+   ActuatorFrame.SaGcmd = ActuatorCmd->SaGcmd;
+
+   REC42_WriteActuatorFrame(&Comm42->Rec42, LinkIndex, Comm42->ExecuteCycleCnt,
+                            Link->SensorDataMsg[Link->SensorDataMsgFront].Payload.GpsTime, &ActuatorFrame);
+
+   if (Link->Index == 0)
    {
       
-      CFE_EVS_SendEvent(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
-                        "**** COMM42_SocketTask(%d) Waiting for semaphore: InitCycle=%d",
-                        Comm42->ExecuteCycleCnt, Comm42->InitCycle);    
+      Comm42->Bc42 = BC42_TakePtr();
       
-      CfeStatus = OS_BinSemTake(Comm42->WakeUpSemaphore); /* Pend until parent app gives semaphore */
-
-      // During an interface shutdown ChildTaskRun is set to false and then the semaphore is given
-      if (Comm42->ChildTaskRun)
+      for (i=0; i < 3; i++) 
       {
+         AC42_(Tcmd[i]) = ActuatorCmd->Tcmd[i];
+         AC42_(Mcmd[i]) = ActuatorCmd->Mcmd[i];
+      }
+      
+      AC42_(G[0].Cmd.Ang[0]) = ActuatorCmd->SaGcmd;
 
-         /* Check connection for termination scenario */
-         if (CfeStatus == CFE_SUCCESS) 
-         {
-            
-            ++Comm42->ExecuteCycleCnt;
-            if (COMM42_RecvSensorData(&(Comm42->SensorDataMsg)) > 0)
-            {
-               CFE_SB_TimeStampMsg(CFE_MSG_PTR(Comm42->SensorDataMsg.TelemetryHeader));
-               CfeStatus = CFE_SB_TransmitMsg(CFE_MSG_PTR(Comm42->SensorDataMsg.TelemetryHeader), true);
-               
-               if (CfeStatus == CFE_SUCCESS)
-               {
-                  ++Comm42->SensorDataMsgCnt;
-                  Comm42->ActuatorCmdMsgSent = false;
-               }
-               CFE_EVS_SendEvent(COMM42_SOCKET_TASK_EID, CFE_EVS_EventType_INFORMATION,
-                     "Sent Sensor data message: cFEStatus=%d, InitCycle= %d, ExecuteCycleCnt=%d, Comm42->SensorDataMsgCnt=%d",
-                     CfeStatus, Comm42->InitCycle, Comm42->ExecuteCycleCnt, Comm42->SensorDataMsgCnt);  
-            }
-            else
-            {
-               CFE_EVS_SendEvent(COMM42_SOCKET_TASK_EID, CFE_EVS_EventType_INFORMATION,
-                                 "Closing socket after received data failure: InitCycle= %d, ExecuteCycleCnt=%d",
-                                 Comm42->InitCycle, Comm42->ExecuteCycleCnt);    
-               COMM42_Close();
-            }
+      if (Link->Wire42.Protocol != WIRE42_PROTOCOL_BINARY)
+      {
          
-         } /* End if valid semaphore */
-      } /* End if run child task */
-   } /* End if socket connected */
-   
-   return Comm42->ChildTaskRun;
-
-} /* End COMM42_SocketTask() */
+         WheelProcessing(AC42);
+         MtbProcessing(AC42);
+      
+         BC42_WriteToSocket(Link->SocketId, &Link->SocketAddr, AC42);
+      
+      }
+      
+      BC42_GivePtr(Comm42->Bc42);
+      
+   } /* End if AcVar link */
 
+   if (Link->Wire42.Protocol == WIRE42_PROTOCOL_BINARY)
+   {
+      SendActuatorFrame(Link, &ActuatorFrame);
+   }
+   else
+   {
+      MarkPhase(Link, PERF42_PHASE_WRITE);
+   }
+   
+   ++Comm42->ActuatorCmdMsgCnt;
+   if (LinkCycleClosed)
+   {
+      Link->ActuatorCmdMsgSent = true;
+      Comm42->ActuatorCmdMsgSent = AllActuatorCmdsSent();
+      if (Comm42->ActuatorCmdMsgSent)
+      {
+         Comm42->InitCycle = false;
+      }
+   }
+   
+   /* The child's current pass starts the pending cycle or prefetch */
+   if (Link->SocketConnected && LinkCycleClosed)
+   {
+      if (Comm42->FreeRun)
+      {
+         if (Comm42->ActuatorCmdMsgSent)
+         {
+            Comm42->CyclePending = true;
+         }
+      }
+      else if (Comm42->SensorPrefetch)
+      {
+         Link->PrefetchPending = true;
+      }
+   }
+      
+   return true;
+
+} /* End COMM42_SendActuatorCmds() */
+
+
+/******************************************************************************
+** Function: COMM42_SetSensorMaskCmd
+**
+** Notes:
+**   1. The child task reads each link's mask when it decodes a sensor frame
+**      so a change applies from the next frame.
+*/
+bool COMM42_SetSensorMaskCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const BC42_INTF_SetSensorMaskCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_SetSensorMaskCmd_t);
+   int i;
+   
+   if ((Cmd->Mask & ~WIRE42_SENSOR_ALL) != 0)
+   {
+      CFE_EVS_SendEvent(COMM42_SENSOR_MASK_EID, CFE_EVS_EventType_ERROR,
+                        "Set sensor mask command rejected, 0x%04X has bits outside of 0x%04X", 
+                        Cmd->Mask, WIRE42_SENSOR_ALL);
+      return false;
+   }
+   
+   Comm42->SensorMask = Cmd->Mask;
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      Comm42->Link[i].Wire42.SensorMask = Cmd->Mask;
+   }
+   
+   CFE_EVS_SendEvent(COMM42_SENSOR_MASK_EID, CFE_EVS_EventType_INFORMATION,
+                     "Sensor mask set to 0x%04X", Comm42->SensorMask);
+   
+   return true;
+   
+} /* End COMM42_SetSensorMaskCmd() */
+
+
+/******************************************************************************
+** Function: COMM42_SetFreeRun
+**
+** Notes:
+**   1. When free running is enabled the next COMM42_ManageExecution() call
+**      starts a cycle if the current cycle is closed.
+**   2. The sim pacing schedule starts over with the next cycle.
+*/
+void COMM42_SetFreeRun(bool FreeRun)
+{
+   
+   Comm42->FreeRun = FreeRun;
+   Comm42->FreeRunCycleCnt = Comm42->ExecuteCycleCnt;
+   Comm42->SimPaceAnchored = false;
+   
+} /* End COMM42_SetFreeRun() */
+
+
+/******************************************************************************
+** Function: COMM42_SetSimRate
+**
+** Notes:
+**   1. The sim pacing schedule starts over with the next cycle.
+*/
+void COMM42_SetSimRate(uint16 SimRate)
+{
+   
+   Comm42->SimRate = SimRate;
+   Comm42->SimPaceAnchored = false;
+   
+} /* End COMM42_SetSimRate() */
+
+
+/******************************************************************************
+** Function: COMM42_Shutdown
+**
+** Close the socket and force a child task exit. The sequence of this code must
+** work with the COMM42_SocketTask() logic to avoid strange. 
+**
+** Notes:
+**   1. The links are closed directly because ES has already deleted the
+**      child task when the app's delete handler runs.
+** 
+*/
+void COMM42_Shutdown(void)
+{
+   
+   CloseLinks();
+   REC42_Close(&Comm42->Rec42);
+   Comm42->ChildTaskRun = false;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
+   
+} /* End COMM42_Shutdown() */
+
+
+/******************************************************************************
+** Function: COMM42_SocketTask
+**
+** Notes:
+**   1. This function is continuously called by the app_c_fw's ChildMgr
+**      service. Returning false causes the child task to terminate.
+**   2. This infinite loop design proved to be the most robust. I tried to 
+**      create/terminate the child task with a socket connect/disconnect and
+**      something didn't seem to get cleaned up properly and the system would
+**      hang on a second connect cmd. 
+**   3. The semaphore wait is limited to ChildWaitTimeout and to the next
+**      connection attempt while automatic connections are enabled and a link
+**      is disconnected.
+**   4. While a link is waiting for its actuator command the child pends on
+**      the actuator pipe instead of the semaphore. The received commands set
+**      the cycle or prefetch that they start and this call's pass serves it.
+**   5. A pending free running cycle doesn't start until its sim pacing delay
+**      expires, the semaphore wait is also limited to the delay.
+**   6. Checkpoint requests are served after the connections are managed so
+**      a restore applies to the links that start the next cycle.
+**   7. Parent requests are served before the connections are managed so a
+**      close followed by a connect reconnects in the same pass.
+**
+*/
+bool COMM42_SocketTask(CHILDMGR_Class_t* ChildMgr)
+{
+      
+   int32  OsStatus;
+   uint32 WaitMsec;
+   uint32 PaceMsec;
+   int    i;
+   COMM42_Link_t *Link;
+   
+   BC42_INTF_CYCLE_EVENT(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
+                         "**** COMM42_SocketTask(%d) Waiting for semaphore: InitCycle=%d",
+                         Comm42->ExecuteCycleCnt, Comm42->InitCycle);    
+   
+   WaitMsec = ConnectWaitMsec();
+   if ((WaitMsec == 0) || ((Comm42->ChildWaitTimeout > 0) && (WaitMsec > Comm42->ChildWaitTimeout)))
+   {
+      WaitMsec = Comm42->ChildWaitTimeout;
+   }
+   PaceMsec = SimPaceWaitMsec();
+   if ((PaceMsec > 0) && ((WaitMsec == 0) || (PaceMsec < WaitMsec)))
+   {
+      WaitMsec = PaceMsec;
+   }
+   
+   if (ActuatorCmdWait())
+   {
+      OsStatus = RecvActuatorCmds();
+   }
+   else if (WaitMsec == 0)
+   {
+      OsStatus = OS_BinSemTake(Comm42->WakeUpSemaphore); /* Pend until parent app gives semaphore */
+   }
+   else
+   {
+      OsStatus = OS_BinSemTimedWait(Comm42->WakeUpSemaphore, WaitMsec);
+   }
+
+   // During an interface shutdown ChildTaskRun is set to false and then the semaphore is given
+   if (Comm42->ChildTaskRun)
+   {
+
+      if ((OsStatus == OS_SUCCESS) || (OsStatus == OS_SEM_TIMEOUT)) 
+      {
+         
+         ServiceRequests();
+         ManageConnections();
+         ServiceCheckpoint();
+         
+         /* Check connection for termination scenario */
+         if (Comm42->SocketConnected) 
+         {
+            
+            for (i=0; i < Comm42->LinkCnt; i++)
+            {
+               
+               Link = &Comm42->Link[i];
+            
+               /* Receive the next cycle's sensor data while waiting for the cycle to start */
+               if (Link->PrefetchPending)
+               {
+                  Link->PrefetchPending = false;
+                  if (Link->SocketConnected)
+                  {
+                     StartSensorRecv(Link);
+                  }
+               }
+            }
+            RecvSensorData(true);
+            
+            if (Comm42->CyclePending && Comm42->SocketConnected && (SimPaceWaitMsec() == 0))
+            {
+               
+               Comm42->CyclePending = false;
+               ++Comm42->ExecuteCycleCnt;
+               
+               for (i=0; i < Comm42->LinkCnt; i++)
+               {
+                  
+                  Link = &Comm42->Link[i];
+                  
+                  if (Link->PrefetchReady)
+                  {
+                     Link->SensorDataMsgFront ^= 1;
+                     Link->PrefetchReady = false;
+                     SendSensorDataMsg(Link);
+                  }
+                  else if (Link->SocketConnected)
+                  {
+                     StartSensorRecv(Link);
+                  }
+               }
+               RecvSensorData(false);
+               
+            } /* End if cycle pending */
+         
+         } /* End if socket connected */
+      } /* End if valid semaphore */
+   } /* End if run child task */
+   
+   return Comm42->ChildTaskRun;
+
+} /* End COMM42_SocketTask() */
+
+
+/******************************************************************************
+** Function: COMM42_StartRecordCmd
+**
+*/
+bool COMM42_StartRecordCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const BC42_INTF_StartRecordCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_StartRecordCmd_t);
+   
+   if (Comm42->RecordRequest != COMM42_RECORD_REQUEST_NONE)
+   {
+      CFE_EVS_SendEvent(COMM42_RECORD_EID, CFE_EVS_EventType_ERROR,
+                        "Start record command rejected, a record request is pending");
+      return false;
+   }
+   
+   strncpy(Comm42->RecordRequestFile, (Cmd->Filename[0] == '\0') ? Comm42->RecordFile : Cmd->Filename, OS_MAX_PATH_LEN);
+   Comm42->RecordRequestFile[OS_MAX_PATH_LEN-1] = '\0';
+   
+   Comm42->RecordRequest = COMM42_RECORD_REQUEST_START;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
+   
+   return true;
+   
+} /* End COMM42_StartRecordCmd() */
+
+
+/******************************************************************************
+** Function: COMM42_StartReplayCmd
+**
+** Notes:
+**   1. Pending connect requests are cancelled so the last command wins.
+*/
+bool COMM42_StartReplayCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   const BC42_INTF_StartReplayCmd_Payload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_INTF_StartReplayCmd_t);
+   
+   if (Comm42->ReplayRequest)
+   {
+      CFE_EVS_SendEvent(COMM42_RECORD_EID, CFE_EVS_EventType_ERROR,
+                        "Start replay command rejected, a replay request is pending");
+      return false;
+   }
+   
+   strncpy(Comm42->ReplayFile, (Cmd->Filename[0] == '\0') ? Comm42->RecordFile : Cmd->Filename, OS_MAX_PATH_LEN);
+   Comm42->ReplayFile[OS_MAX_PATH_LEN-1] = '\0';
+   
+   Comm42->ConnectRequest = false;
+   Comm42->ReplayRequest  = true;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
+   
+   return true;
+   
+} /* End COMM42_StartReplayCmd() */
+
+
+/******************************************************************************
+** Function: COMM42_StopRecordCmd
+**
+*/
+bool COMM42_StopRecordCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   
+   if (Comm42->RecordRequest != COMM42_RECORD_REQUEST_NONE)
+   {
+      CFE_EVS_SendEvent(COMM42_RECORD_EID, CFE_EVS_EventType_ERROR,
+                        "Stop record command rejected, a record request is pending");
+      return false;
+   }
+   
+   Comm42->RecordRequest = COMM42_RECORD_REQUEST_STOP;
+   OS_BinSemGive(Comm42->WakeUpSemaphore);
+   
+   return true;
+   
+} /* End COMM42_StopRecordCmd() */
+
+
+/******************************************************************************
+** Function: COMM42_TransportStr
+**
+*/
+const char *COMM42_TransportStr(COMM42_Transport_t Transport)
+{
+   
+   const char *TransportStr = COMM42_TRANSPORT_SOCKET_STR;
+   
+   if (Transport == COMM42_TRANSPORT_SHM)
+   {
+      TransportStr = COMM42_TRANSPORT_SHM_STR;
+   }
+   else if (Transport == COMM42_TRANSPORT_UDP)
+   {
+      TransportStr = COMM42_TRANSPORT_UDP_STR;
+   }
+   
+   return TransportStr;
+   
+} /* End COMM42_TransportStr() */
+
+
+/******************************************************************************
+** Function: AbortSensorRecv
+**
+** The sensor data watchdog expired for a link. Discard any partial binary
+** frame and close the link so the stream restarts from a new connection. 42
+** exchanges are lock step so a lost sensor frame can't be skipped.
+*/
+static void AbortSensorRecv(COMM42_Link_t *Link)
+{
+   
+   uint32 DiscardLen = 0;
+   
+   ++Link->SensorStallCnt;
+   ++Comm42->SensorStallCnt;
+   
+   if (Link->Wire42.Protocol == WIRE42_PROTOCOL_BINARY)
+   {
+      DiscardLen = WIRE42_Resync(&Link->Wire42);
+   }
+   
+   TRACE42_Record(&Comm42->Trace42, COMM42_TRACE_SENSOR_STALL, Comm42->ExecuteCycleCnt,
+                  Link->Index, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt);
+   CFE_EVS_SendEvent(COMM42_WATCHDOG_EID, CFE_EVS_EventType_ERROR,
+                     "Link %d sensor data not received within %d ms, discarded %d bytes of a partial frame. Closing link to resynchronize",
+                     Link->Index, (int)Comm42->SensorTimeout, (int)DiscardLen);
+   
+   CloseLink(Link);
+   
+} /* End AbortSensorRecv() */
+
+
+/******************************************************************************
+** Function: AcVarToSensorFrame
+**
+** Notes:
+**   1. The caller must hold the AcVar lock.
+**
+*/
+static void AcVarToSensorFrame(WIRE42_SensorFrame_t *SensorFrame)
+{
+   
+   int i;
+   
+   SensorFrame->Time     = AC42_(Time);
+   SensorFrame->SunValid = AC42_(SunValid);
+   for (i=0; i < 3; i++)
+   {
+      SensorFrame->PosN[i] = AC42_(PosN[i]);
+      SensorFrame->VelN[i] = AC42_(VelN[i]);
+      SensorFrame->wbn[i]  = AC42_(wbn[i]);
+      SensorFrame->svb[i]  = AC42_(svb[i]);
+      SensorFrame->bvb[i]  = AC42_(bvb[i]);
+   }
+   for (i=0; i < 4; i++)
+   {
+      SensorFrame->qbn[i]  = AC42_(qbn[i]);
+      SensorFrame->WhlH[i] = AC42_(Whl[i].H);
+   }
+   
+} /* End AcVarToSensorFrame() */
+
+
+/******************************************************************************
+** Function: AcceptCycleTag
+**
+** Record an accepted tagged actuator command's cycle and measure the cycle
+** latency, the time from sending the sensor data message to receiving its
+** command. Cycles skipped by the command are counted as lost.
+** CheckCycleTag() must have accepted the command.
+*/
+static void AcceptCycleTag(COMM42_Link_t *Link, const BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmd)
+{
+   
+   int64     LatencyUsec;
+   OS_time_t Now;
+   const COMM42_CycleTag_t *CycleTag = &Link->CycleTag[ActuatorCmd->CycleId % COMM42_CYCLE_TAG_CNT];
+   
+   if (ActuatorCmd->CycleId != 0)
+   {
+      
+      Link->CycleLostCnt   += (uint16)(ActuatorCmd->CycleId - Link->AnsweredCycleId - 1);
+      Link->AnsweredCycleId = ActuatorCmd->CycleId;
+      
+      CFE_PSP_GetTime(&Now);
+      LatencyUsec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Now, CycleTag->SendTime));
+      Link->CycleLatencyUsec = (LatencyUsec > 0) ? (uint32)LatencyUsec : 0;
+      if (Link->CycleLatencyUsec > Link->CycleLatencyMaxUsec)
+      {
+         Link->CycleLatencyMaxUsec = Link->CycleLatencyUsec;
+      }
+   }
+   
+} /* End AcceptCycleTag() */
+
+
+/******************************************************************************
+** Function: ActuatorCmdWait
+**
+** Return true if a connected link has published sensor data and is waiting
+** for the exchange's actuator commands.
+*/
+static bool ActuatorCmdWait(void)
+{
+   
+   int i;
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      if (Comm42->Link[i].SocketConnected && Comm42->Link[i].ActuatorCmdWait)
+      {
+         return true;
+      }
+   }
+   
+   return false;
+   
+} /* End ActuatorCmdWait() */
+
+
+/******************************************************************************
+** Function: AllActuatorCmdsSent
+**
+** Return true if every connected link has sent the current cycle's actuator
+** command.
+*/
+static bool AllActuatorCmdsSent(void)
+{
+   
+   int i;
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      if (Comm42->Link[i].SocketConnected && !Comm42->Link[i].ActuatorCmdMsgSent)
+      {
+         return false;
+      }
+   }
+   
+   return true;
+   
+} /* End AllActuatorCmdsSent() */
+
+
+/******************************************************************************
+** Function: CheckCycleTag
+**
+** Check a tagged actuator command against the link's published cycles. A
+** rejected command is counted and reported. Returns false if the command is
+** rejected. The link's state is left unchanged so a command can be checked
+** before it's coalesced and again before it's sent.
+**
+** Notes:
+**   1. A controller echoes the CycleId and GpsTime of the sensor data message
+**      it answers. A command is late if its cycle was already answered or
+**      belongs to an earlier exchange, and a mismatch if it doesn't echo a
+**      message published in the last COMM42_CYCLE_TAG_CNT cycles.
+**   2. A zero CycleId is an untagged command and is accepted.
+*/
+static bool CheckCycleTag(COMM42_Link_t *Link, const BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmd)
+{
+   
+   bool TagValid = false;
+   const COMM42_CycleTag_t *CycleTag = &Link->CycleTag[ActuatorCmd->CycleId % COMM42_CYCLE_TAG_CNT];
+   
+   if (ActuatorCmd->CycleId == 0)
+   {
+      return true;
+   }
+   
+   if ((ActuatorCmd->CycleId <= Link->AnsweredCycleId) ||
+       ((ActuatorCmd->CycleId + Link->ExchangeSteps) <= Link->CycleId))
+   {
+      ++Link->CycleLateCnt;
+      CFE_EVS_SendEvent(COMM42_CYCLE_TAG_EID, CFE_EVS_EventType_ERROR,
+                        "Link %d actuator command for cycle %u rejected as late, cycle %u is published and %u is answered",
+                        Link->Index, (unsigned int)ActuatorCmd->CycleId, (unsigned int)Link->CycleId,
+                        (unsigned int)Link->AnsweredCycleId);
+   }
+   else if ((ActuatorCmd->CycleId > Link->CycleId) || (CycleTag->CycleId != ActuatorCmd->CycleId) ||
+            (CycleTag->SensorTime != ActuatorCmd->SensorTime))
+   {
+      ++Link->CycleMismatchCnt;
+      CFE_EVS_SendEvent(COMM42_CYCLE_TAG_EID, CFE_EVS_EventType_ERROR,
+                        "Link %d actuator command for cycle %u at sensor time %.3f rejected, it doesn't match a published cycle",
+                        Link->Index, (unsigned int)ActuatorCmd->CycleId, ActuatorCmd->SensorTime);
+   }
+   else
+   {
+      TagValid = true;
+   }
+   
+   return TagValid;
+   
+} /* End CheckCycleTag() */
+
+
+/******************************************************************************
+** Function: CheckTransport
+**
+** Return Transport if it can be used with the configured wire protocol,
+** otherwise report it and return the socket transport.
+*/
+static COMM42_Transport_t CheckTransport(COMM42_Transport_t Transport)
+{
+   
+   if ((Transport != COMM42_TRANSPORT_SOCKET) && (Comm42->WireProtocolCfg != WIRE42_PROTOCOL_BINARY))
+   {
+      CFE_EVS_SendEvent(COMM42_TRANSPORT_EID, CFE_EVS_EventType_ERROR,
+                        "%s transport requested without the %s wire protocol. Using the %s transport", 
+                        COMM42_TransportStr(Transport), WIRE42_PROTOCOL_BINARY_STR, COMM42_TRANSPORT_SOCKET_STR);
+      Transport = COMM42_TRANSPORT_SOCKET;
+   }
+   
+   return Transport;
+   
+} /* End CheckTransport() */
+
+
+/******************************************************************************
+** Function: CloseLink
+**
+** Notes:
+**   1. When the last connected link is closed the COMM42 cycle state is
+**      reset. The counters are also reset unless the link will be
+**      reconnected.
+**   2. A reconnection isn't attempted for the minimum backoff period so a
+**      restarting 42 has time to begin listening.
+*/
+static void CloseLink(COMM42_Link_t *Link)
+{
+   
+   int i;
+   
+   if (Link->SocketConnected == true)
+   {
+    
+      if (Link->Replay)
+      {
+         REC42_Close(&Link->Replay42);
+         Link->Replay = false;
+      }
+      else if (Link->Wire42.Shm42 != NULL)
+      {
+         SHM42_Close(&Link->Shm42);
+         Link->Wire42.Shm42 = NULL;
+         CFE_EVS_SendEvent(COMM42_SOCKET_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Successfully closed link %d shared memory", Link->Index);
+      }
+      else
+      {
+         OS_close(Link->SocketId);
+         CFE_EVS_SendEvent(COMM42_SOCKET_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Successfully closed link %d socket", Link->Index);
+      }
+   
+      Link->SocketConnected = false;
+      TRACE42_Record(&Comm42->Trace42, COMM42_TRACE_SOCKET_CLOSE, Comm42->ExecuteCycleCnt,
+                     Link->Index, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt);
+      
+   } /* End if connected */
+
+   Link->ActuatorCmdMsgSent = false;
+   Link->ActuatorCmdWait = false;
+   Link->SensorDataRecv  = false;
+   Link->PrefetchPending = false;
+   Link->PrefetchReady   = false;
+   Link->Wire42.Protocol = WIRE42_PROTOCOL_ASCII;
+   Link->ExchangeSteps    = 1;
+   Link->SensorStepCnt    = 0;
+   Link->ActuatorStepCnt  = 0;
+   Link->ActuatorBatchCnt = 0;
+   
+   Link->ConnectBackoff = Comm42->ConnectBackoffMin;
+   CFE_PSP_GetTime(&Link->ConnectTime);
+   Link->ConnectTime = OS_TimeAdd(Link->ConnectTime, OS_TimeFromTotalMilliseconds(Link->ConnectBackoff));
+   
+   Comm42->SocketConnected = false;
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      if (Comm42->Link[i].SocketConnected)
+      {
+         Comm42->SocketConnected = true;
+      }
+   }
+   
+   if (!Comm42->SocketConnected)
+   {
+      Comm42->ActuatorCmdMsgSent = false;
+      if (!Comm42->AutoConnect)
+      {
+         COMM42_ResetStatus();
+      }
+   }
+   
+} /* End CloseLink() */
+
+
+/******************************************************************************
+** Function: CloseLinks
+**
+** Close all of the links and stop automatic connections.
+*/
+static void CloseLinks(void)
+{
+
+   int i;
+   
+   Comm42->AutoConnect = false;
+   
+   if (Comm42->SocketConnected == false)
+   {
+      CFE_EVS_SendEvent(COMM42_SOCKET_CLOSE_EID, CFE_EVS_EventType_DEBUG,
+                        "Attempt to close socket without a connection");
+   }
+
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      CloseLink(&Comm42->Link[i]);
+   }
+
+} /* End CloseLinks() */
+
+
+/******************************************************************************
+** Function: ConnectLink
+**
+** Notes:
+**   1. When the binary wire protocol is configured it is negotiated after the
+**      connection is established. Stock 42 only speaks the ASCII records and
+**      doesn't answer the hello frame, so the protocol is an explicit ini
+**      choice and isn't probed. A link that isn't acknowledged is closed and
+**      retried after the connection backoff like any other failed connect.
+*/
+static bool ConnectLink(COMM42_Link_t *Link, const char *AddrStr, uint32 Port)
+{
+   
+   Link->Wire42.Protocol = WIRE42_PROTOCOL_ASCII;
+   Link->ActuatorCmdMsgSent = false;
+   Link->ActuatorCmdWait = false;
+   Link->SensorDataRecv  = false;
+   Link->PrefetchPending = false;
+   Link->PrefetchReady   = false;
+   Link->ExchangeSteps    = 1;   /* 42 sends one sensor frame after connecting */
+   Link->SensorStepCnt    = 0;
+   Link->ActuatorStepCnt  = 0;
+   Link->ActuatorBatchCnt = 0;
+   Link->AnsweredCycleId  = Link->CycleId;
+   DELTA42_Reset(&Link->Delta42);
+   GROUP42_Reset(&Link->Group42);
+   
+   if ((Comm42->Transport == COMM42_TRANSPORT_SHM) ? OpenShm(Link) : OpenSocket(Link, AddrStr, Port))
+   {
+      
+      if (Comm42->WireProtocolCfg == WIRE42_PROTOCOL_BINARY)
+      {
+         if (!WIRE42_Negotiate(&Link->Wire42, Link->SocketId, Comm42->WireHelloTimeout))
+         {
+            CFE_EVS_SendEvent(COMM42_SOCKET_CONNECT_EID, CFE_EVS_EventType_ERROR, 
+                              "Link %d %s peer didn't acknowledge the binary protocol, closing link", 
+                              Link->Index, COMM42_TransportStr(Comm42->Transport));
+            CloseLink(Link);
+         }
+      }
+      
+   } /* End if open */
+   
+   return Link->SocketConnected;
+   
+} /* End ConnectLink() */
+
+
+/******************************************************************************
+** Function: ConnectWaitMsec
+**
+** Return the milliseconds until the next link connection attempt is due or
+** zero if no attempts are scheduled.
+**
+** Notes:
+**   1. An attempt that is already due returns one millisecond so the caller
+**      can always use a non-zero value as a timeout.
+*/
+static uint32 ConnectWaitMsec(void)
+{
+   
+   int       i;
+   int64     WaitMsec;
+   uint32    MinWaitMsec = 0;
+   OS_time_t Now;
+   
+   if (Comm42->AutoConnect)
+   {
+      
+      CFE_PSP_GetTime(&Now);
+      
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         if (!Comm42->Link[i].SocketConnected)
+         {
+            
+            WaitMsec = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Comm42->Link[i].ConnectTime, Now));
+            if (WaitMsec < 1)
+            {
+               WaitMsec = 1;
+            }
+            if ((MinWaitMsec == 0) || (WaitMsec < MinWaitMsec))
+            {
+               MinWaitMsec = (uint32)WaitMsec;
+            }
+         }
+      }
+   }
+   
+   return MinWaitMsec;
+   
+} /* End ConnectWaitMsec() */
+
+
+/******************************************************************************
+** Function: CycleBoundary
+**
+** Return true if no connected link is part way through a cycle.
+*/
+static bool CycleBoundary(void)
+{
+   
+   int  i;
+   bool Boundary = true;
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      if (Comm42->Link[i].SocketConnected && 
+          (Comm42->Link[i].ActuatorCmdWait || Comm42->Link[i].SensorDataRecv))
+      {
+         Boundary = false;
+      }
+   }
+   
+   return Boundary;
+   
+} /* End CycleBoundary() */
+
+
+/******************************************************************************
+** Function: LoadSensorData
+**
+** Notes:
+**   1. The fields of sensors that aren't in the sensor mask are zeroed and
+**      marked invalid. This covers ASCII and replayed frames that weren't
+**      masked when they were decoded.
+*/
+static void LoadSensorData(BC42_INTF_SensorDataMsg_Payload_t *SensorData,
+                           const WIRE42_SensorFrame_t *SensorFrame)
+{
+   
+   int    i;
+   uint16 Mask = Comm42->SensorMask;
+   
+   SensorData->GpsTime = SensorFrame->Time; 
+   SensorData->GpsValid   = ((Mask & WIRE42_SENSOR_GPS) != 0);
+   SensorData->StValid    = ((Mask & WIRE42_SENSOR_ST) != 0);
+   SensorData->SunValid   = SensorFrame->SunValid && ((Mask & WIRE42_SENSOR_SUN) != 0);
+   SensorData->InitCycle  = Comm42->InitCycle;
+   SensorData->SensorMask = Mask;
+
+   for (i=0; i < 3; i++) {
+   
+      SensorData->PosN[i] = (Mask & WIRE42_SENSOR_GPS)  ? SensorFrame->PosN[i] : 0.0;  /* GPS */
+      SensorData->VelN[i] = (Mask & WIRE42_SENSOR_GPS)  ? SensorFrame->VelN[i] : 0.0;
+   
+      SensorData->qbn[i]  = (Mask & WIRE42_SENSOR_ST)   ? SensorFrame->qbn[i]  : 0.0;  /* ST */
+
+      SensorData->wbn[i]  = (Mask & WIRE42_SENSOR_GYRO) ? SensorFrame->wbn[i]  : 0.0;  /* Gyro */
+   
+      SensorData->svb[i]  = (Mask & WIRE42_SENSOR_SUN)  ? SensorFrame->svb[i]  : 0.0;  /* CSS/FSS */
+
+      SensorData->bvb[i]  = (Mask & WIRE42_SENSOR_MAG)  ? SensorFrame->bvb[i]  : 0.0;  /* MTB */
+   
+      SensorData->WhlH[i] = (Mask & WIRE42_SENSOR_WHL)  ? SensorFrame->WhlH[i] : 0.0;  /* Wheels */
+   }
+
+   SensorData->qbn[3]  = (Mask & WIRE42_SENSOR_ST)  ? SensorFrame->qbn[3]  : 0.0;
+   SensorData->WhlH[3] = (Mask & WIRE42_SENSOR_WHL) ? SensorFrame->WhlH[3] : 0.0;
+   
+} /* End LoadSensorData() */
+
+
+/******************************************************************************
+** Function: ManageConnections
+**
+** Attempt the due connections of the disconnected links.
+**
+** Notes:
+**   1. The first link to connect starts an initialization cycle. A link that
+**      connects while others are connected is marked as having sent its
+**      actuator command so it doesn't hold open the current cycle and it
+**      joins the next cycle.
+**   2. The backoff doubles after each failed attempt up to the ini file limit
+**      and is cleared when the link connects.
+**   3. OSAL's socket connect blocks for up to ConnectTimeout and the
+**      negotiation for up to WireHelloTimeout, which stalls every connected
+**      link's I/O. While a link is connected only one attempt is made per
+**      pass, so a dead link costs the connected links at most one
+**      ConnectTimeout per backoff interval. A refused connection returns
+**      immediately so the full timeout is only paid when the host doesn't
+**      answer, keep ConnectTimeout short.
+*/
+static void ManageConnections(void)
+{
+   
+   int       i;
+   bool      WasConnected;
+   bool      PassConnected = Comm42->SocketConnected;
+   bool      Attempted = false;
+   OS_time_t Now;
+   COMM42_Link_t *Link;
+   
+   if (!Comm42->AutoConnect)
+   {
+      return;
+   }
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      
+      Link = &Comm42->Link[i];
+      CFE_PSP_GetTime(&Now);
+
+      if (Link->SocketConnected || (OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Link->ConnectTime, Now)) > 0))
+      {
+         continue;
+      }
+      if (Attempted && PassConnected)
+      {
+         break;
+      }
+      
+      Attempted    = true;
+      WasConnected = Comm42->SocketConnected;
+      
+      if (ConnectLink(Link, Comm42->IpAddrStr, Link->Port))
+      {
+         
+         ++Comm42->ConnectCnt;
+         Link->ConnectBackoff = 0;
+         TRACE42_Record(&Comm42->Trace42, COMM42_TRACE_SOCKET_CONNECT, Comm42->ExecuteCycleCnt,
+                        Link->Index, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt);
+         
+         if (WasConnected)
+         {
+            Link->ActuatorCmdMsgSent = true;
+         }
+         else
+         {
+            Comm42->InitCycle = true;
+            Comm42->ActuatorCmdMsgSent = false;
+            Comm42->CyclePending = true;
+         }
+      }
+      else
+      {
+         
+         if (Link->ConnectBackoff < Comm42->ConnectBackoffMin)
+         {
+            Link->ConnectBackoff = Comm42->ConnectBackoffMin;
+         }
+         else
+         {
+            Link->ConnectBackoff *= 2;
+         }
+         if (Link->ConnectBackoff > Comm42->ConnectBackoffMax)
+         {
+            Link->ConnectBackoff = Comm42->ConnectBackoffMax;
+         }
+         
+         CFE_PSP_GetTime(&Link->ConnectTime);
+         Link->ConnectTime = OS_TimeAdd(Link->ConnectTime, OS_TimeFromTotalMilliseconds(Link->ConnectBackoff));
+         
+         CFE_EVS_SendEvent(COMM42_RECONNECT_EID, CFE_EVS_EventType_INFORMATION,
+                           "Link %d connection to %s port %d failed, retrying in %d ms",
+                           Link->Index, Comm42->IpAddrStr, Link->Port, (int)Link->ConnectBackoff);
+      }
+      
+   } /* End link loop */
+   
+} /* End ManageConnections() */
+
+
+/******************************************************************************
+** Function: MarkPhase
+**
+** Add a link's cycle phase to the cycle trace. PERF42 only times the first
+** link so the histograms aren't skewed by interleaved links.
+*/
+static void MarkPhase(const COMM42_Link_t *Link, PERF42_Phase_t Phase)
+{
+   
+   if (Link->Index == 0)
+   {
+      PERF42_Mark(&Comm42->Perf42, Phase);
+   }
+   TRACE42_Record(&Comm42->Trace42, Phase, Comm42->ExecuteCycleCnt, Link->Index,
+                  Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt);
+   
+} /* End MarkPhase() */
+
+
+/******************************************************************************
+** Function: OpenShm
+**
+** Open a link's shared memory segment and make it the link's WIRE42
+** transport. The link's SocketConnected is set to the result.
+*/
+static bool OpenShm(COMM42_Link_t *Link)
+{
+   
+   Link->SocketConnected = false;
+   
+   if (SHM42_Open(&Link->Shm42, Link->ShmName))
+   {
+      Link->Wire42.Shm42      = &Link->Shm42;
+      Link->Wire42.Datagram   = false;
+      Link->SocketConnected   = true;
+      Comm42->SocketConnected = true;
+      CFE_EVS_SendEvent(COMM42_SOCKET_CONNECT_EID, CFE_EVS_EventType_INFORMATION, 
+                        "Successfully connected link %d to shared memory %s", Link->Index, Link->ShmName);
+   }
+   
+   return Link->SocketConnected;
+   
+} /* End OpenShm() */
+
+
+/******************************************************************************
+** Function: OpenSocket
+**
+** Open and connect a link's socket. The link's SocketConnected is set to the
+** result.
+**
+** Notes:
+**   1. A UDP socket is connected so it only receives 42's datagrams and each
+**      read and write is one datagram.
+*/
+static bool OpenSocket(COMM42_Link_t *Link, const char *AddrStr, uint32 Port)
+{
+   
+   int32 Status;
+   
+   Link->SocketConnected = false;
+   Link->Wire42.Datagram = (Comm42->Transport == COMM42_TRANSPORT_UDP);
+   
+   Status = OS_SocketOpen(&Link->SocketId, OS_SocketDomain_INET, 
+                          Link->Wire42.Datagram ? OS_SocketType_DATAGRAM : OS_SocketType_STREAM);
+   if (Status == OS_SUCCESS)
+   {
+      
+      CFE_EVS_SendEvent(COMM42_SOCKET_OPEN_EID, CFE_EVS_EventType_INFORMATION, 
+                        "Successfully opened socket, ID = %d", (int)Link->SocketId);
+
+      OS_SocketAddrInit(&Link->SocketAddr, OS_SocketDomain_INET);
+      OS_SocketAddrFromString(&Link->SocketAddr, AddrStr);   
+      OS_SocketAddrSetPort(&Link->SocketAddr, Port);
+   
+      Status = OS_SocketConnect(Link->SocketId, &Link->SocketAddr, Comm42->ConnectTimeout);
+      if (Status == OS_SUCCESS)
+      {
+         Link->SocketConnected   = true;
+         Comm42->SocketConnected = true;
+         CFE_EVS_SendEvent(COMM42_SOCKET_CONNECT_EID, CFE_EVS_EventType_INFORMATION, 
+                           "Successfully connected to socket address %s, listening on port %d",
+                           AddrStr, (int)Port);
+         
+      }
+      else
+      {
+         OS_close(Link->SocketId);
+         CFE_EVS_SendEvent(COMM42_SOCKET_CONNECT_EID, CFE_EVS_EventType_ERROR, 
+                           "Error connecting to socket address %s, OS_SocketConnect() return code = %d", 
+                           AddrStr, (int)Status);
+      }
+   } /* End if open */
+   else
+   {
+      CFE_EVS_SendEvent(COMM42_SOCKET_OPEN_EID, CFE_EVS_EventType_ERROR, 
+                        "Error opening socket. OS_SocketOpen() return code = %d", (int)Status);
+   }
+   
+   return Link->SocketConnected;
+   
+} /* End OpenSocket() */
+
+
+/******************************************************************************
+** Function: ReadSensorFrame
+**
+** Read a link's sensor data without waiting.
+**
+** Notes:
+**   1. Returns the number of bytes read, OS_ERROR_TIMEOUT if a complete
+**      binary frame hasn't arrived, or zero or a negative value if the socket
+**      closed or a read error occurred.
+**   2. The ASCII records are only read after the socket is readable and
+**      BC42_LIB's parser reads a complete record set.
+*/
+static int32 ReadSensorFrame(COMM42_Link_t *Link, WIRE42_SensorFrame_t *SensorFrame)
+{
+   
+   int32 NumBytesRead;
+   
+   if (Link->Wire42.Protocol == WIRE42_PROTOCOL_BINARY)
+   {
+      
+      /* 
+      ** Binary frames carry processed sensor values so no AcApp processing is
+      ** needed. Frames that arrived with a previous read are taken from the
+      ** WIRE42 receive ring without a socket read. The AcVar lock is only
+      ** taken to copy the first link's snapshot into AcVar after the read.
+      ** Recorded frames are the same snapshots.
+      */
+      if (Link->Replay)
+      {
+         NumBytesRead = REC42_ReadSensorFrame(&Link->Replay42, Link->Index, SensorFrame);
+      }
+      else
+      {
+         NumBytesRead = WIRE42_RecvSensorFrame(&Link->Wire42, Link->SocketId, 0, SensorFrame);
+      }
+      if (NumBytesRead > 0)
+      {
+         MarkPhase(Link, PERF42_PHASE_READ);
+         if (Link->Index == 0)
+         {
+            Comm42->Bc42 = BC42_TakePtr();
+            SensorFrameToAcVar(SensorFrame);
+            BC42_GivePtr(Comm42->Bc42);
+         }
+      }
+   }
+   else
+   {
+      
+      Comm42->Bc42 = BC42_TakePtr();
+      AC42_(EchoEnabled) = false;
+
+      NumBytesRead = BC42_ReadFromSocket(Link->SocketId, &Link->SocketAddr, &Comm42->Bc42->AcVar);
+   
+      if (NumBytesRead > 0)
+      {
+         MarkPhase(Link, PERF42_PHASE_READ);
+         if (Comm42->SensorMask & WIRE42_SENSOR_GYRO) GyroProcessing(AC42);
+         if (Comm42->SensorMask & WIRE42_SENSOR_MAG)  MagnetometerProcessing(AC42);
+         if (Comm42->SensorMask & WIRE42_SENSOR_CSS)  CssProcessing(AC42);
+         if (Comm42->SensorMask & WIRE42_SENSOR_FSS)  FssProcessing(AC42);
+         if (Comm42->SensorMask & WIRE42_SENSOR_ST)   StarTrackerProcessing(AC42);
+         if (Comm42->SensorMask & WIRE42_SENSOR_GPS)  GpsProcessing(AC42);
+         AcVarToSensorFrame(SensorFrame);
+      }
+      
+      BC42_GivePtr(Comm42->Bc42);
+   }
+   
+   return NumBytesRead;
+   
+} /* End ReadSensorFrame() */
+
+
+/******************************************************************************
+** Function: RecvActuatorCmds
+**
+** Pend on the actuator pipe for up to ActuatorPipeTimeout, drain every queued
+** actuator command message and pass the newest command for each link to
+** COMM42_SendActuatorCmds(). Returns OS_SUCCESS if a
+** command was processed and OS_SEM_TIMEOUT otherwise so the caller can treat
+** it like a semaphore wait.
+**
+** Notes:
+**   1. The SB buffer is only valid until the next receive so a coalesced
+**      command is copied into its link.
+**   2. A message with the wrong length is counted and dropped before it's
+**      coalesced or passed on so an older controller's shorter message is
+**      never read past its end.
+**   3. A command's cycle tag is checked before it's coalesced so a late or
+**      mismatched command never supersedes an accepted one.
+**   4. A command for a link that isn't waiting answers a cycle that has
+**      already closed so it's counted as stale and dropped. A batched
+**      exchange needs a command for each step so a batched link's commands
+**      are passed on in order.
+**   5. The pipe is serviced by the child so a cycle's closing command never
+**      waits behind ground commands or the parent's execute and housekeeping
+**      processing.
+*/
+static int32 RecvActuatorCmds(void)
+{
+   
+   int32  SbStatus;
+   int32  RetStatus = OS_SEM_TIMEOUT;
+   int    i;
+   uint16 LinkIndex;
+   COMM42_Link_t   *Link;
+   CFE_SB_Buffer_t *SbBufPtr;
+   CFE_SB_MsgId_t  MsgId = CFE_SB_INVALID_MSG_ID;
+   CFE_MSG_Size_t  MsgSize = 0;
+   
+   SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Comm42->ActuatorPipe, Comm42->ActuatorPipeTimeout);
+   
+   while (SbStatus == CFE_SUCCESS)
+   {
+      
+      if (CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId) == CFE_SUCCESS)
+      {
+         if ((LinkIndex = COMM42_GetActuatorCmdLink(MsgId)) != COMM42_LINK_UNDEF)
+         {
+            
+            Link = &Comm42->Link[LinkIndex];
+            
+            if ((CFE_MSG_GetSize(&SbBufPtr->Msg, &MsgSize) != CFE_SUCCESS) ||
+                (MsgSize != sizeof(BC42_INTF_ActuatorCmdMsg_t)))
+            {
+               ++Link->ActuatorLenErrCnt;
+               CFE_EVS_SendEvent(COMM42_ACTUATOR_LEN_EID, CFE_EVS_EventType_ERROR,
+                                 "Link %d actuator command dropped, length %d isn't %d",
+                                 LinkIndex, (int)MsgSize, (int)sizeof(BC42_INTF_ActuatorCmdMsg_t));
+            }
+            else if (!Link->ActuatorCmdWait)
+            {
+               ++Link->ActuatorStaleCnt;
+            }
+            else if (Link->ExchangeSteps > 1)
+            {
+               COMM42_SendActuatorCmds(LinkIndex, (const BC42_INTF_ActuatorCmdMsg_t *)&SbBufPtr->Msg);
+               RetStatus = OS_SUCCESS;
+            }
+            else if (CheckCycleTag(Link, &((const BC42_INTF_ActuatorCmdMsg_t *)&SbBufPtr->Msg)->Payload))
+            {
+               if (Link->ActuatorCmdLatched)
+               {
+                  ++Link->ActuatorSupersededCnt;
+               }
+               memcpy(&Link->ActuatorCmdLatest, &SbBufPtr->Msg, sizeof(BC42_INTF_ActuatorCmdMsg_t));
+               Link->ActuatorCmdLatched = true;
+            }
+         }
+      }
+      
+      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Comm42->ActuatorPipe, CFE_SB_POLL);
+   
+   }
+   
+   for (i=0; i < Comm42->LinkCnt; i++)
+   {
+      
+      Link = &Comm42->Link[i];
+      
+      if (Link->ActuatorCmdLatched)
+      {
+         Link->ActuatorCmdLatched = false;
+         COMM42_SendActuatorCmds(i, &Link->ActuatorCmdLatest);
+         RetStatus = OS_SUCCESS;
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End RecvActuatorCmds() */
+
+
+/******************************************************************************
+** Function: RecvLinkSensorData
+**
+** Read sensor data and load the link's sensor data message. A prefetch loads
+** the back buffer, otherwise the front buffer is loaded and published.
+*/
+static void RecvLinkSensorData(COMM42_Link_t *Link, bool Prefetch)
+{
+   
+   int32 NumBytesRead;
+   WIRE42_SensorFrame_t SensorFrame;
+   BC42_INTF_SensorDataMsg_t *SensorDataMsg = &Link->SensorDataMsg[Prefetch ? (Link->SensorDataMsgFront ^ 1) : Link->SensorDataMsgFront];
+
+   BC42_INTF_CYCLE_EVENT(COMM42_DEBUG_EID, CFE_EVS_EventType_DEBUG,
+                         "**** RecvLinkSensorData(%d): ExecCnt=%d, SensorCnt=%d, ActuatorCnt=%d, Prefetch=%d",
+                         Link->Index, Comm42->ExecuteCycleCnt, Comm42->SensorDataMsgCnt, Comm42->ActuatorCmdMsgCnt, Prefetch);
+
+   NumBytesRead = ReadSensorFrame(Link, &SensorFrame);
+   
+   if (NumBytesRead > 0)
+   {
+      
+      REC42_WriteSensorFrame(&Comm42->Rec42, Link->Index, Comm42->ExecuteCycleCnt, &SensorFrame);
+      CFE_PSP_GetTime(&Link->SensorWaitTime);
+      Link->ResendWaitCnt = 0;
+      LoadSensorData(&SensorDataMsg->Payload, &SensorFrame);
+      MarkPhase(Link, PERF42_PHASE_PROCESS);
+      
+      if (++Link->SensorStepCnt >= Link->ExchangeSteps)
+      {
+         Link->SensorStepCnt  = 0;
+         Link->SensorDataRecv = false;
+      }
+      if (Prefetch)
+      {
+         Link->PrefetchReady = true;
+      }
+      else
+      {
+         SendSensorDataMsg(Link);
+      }
+   }
+   else if (Link->Replay)
+   {
+      CFE_EVS_SendEvent(COMM42_SOCKET_TASK_EID, CFE_EVS_EventType_INFORMATION,
+                        "Link %d replay stopped at the end of %s, status=%d",
+                        Link->Index, Link->Replay42.Filename, (int)NumBytesRead);    
+      CloseLink(Link);
+   }
+   else if (NumBytesRead != OS_ERROR_TIMEOUT)
+   {
+      CFE_EVS_SendEvent(COMM42_SOCKET_TASK_EID, CFE_EVS_EventType_INFORMATION,
+                        "Closing link %d socket after received data failure: InitCycle= %d, ExecuteCycleCnt=%d, Prefetch=%d",
+                        Link->Index, Comm42->InitCycle, Comm42->ExecuteCycleCnt, Prefetch);    
+      CloseLink(Link);
+   }
+   
+} /* End RecvLinkSensorData() */
+
+
+/******************************************************************************
+** Function: RecvSensorData
+**
+** Receive sensor data for every link with SensorDataRecv set.
+**
+** Notes:
+**   1. Replayed links and binary frames already in a link's receive ring are
+**      processed without waiting, this includes the rest of a batch that
+**      arrived with one read. The remaining link sockets are waited on
+**      together and each link is processed as soon as its socket is readable
+**      so a slow spacecraft doesn't delay the others' sensor data messages.
+**   2. The socket wait is limited to the earliest link watchdog expiration.
+**      A link whose watchdog expired is aborted before the next wait.
+**   3. Shared memory links have no descriptor for the socket select so they
+**      are read as soon as their segment is readable. When they are the only
+**      pending links the child pends on the first pending link's doorbell,
+**      polling every COMM42_SHM_POLL_MSEC while more than one is pending.
+**   4. The wait is also limited to the earliest UDP actuator resend.
+*/
+static void RecvSensorData(bool Prefetch)
+{
+   
+   int      i;
+   int32    Status;
+   int32    WaitMsec;
+   int64    RemainMsec;
+   uint16   PendingCnt;
+   uint16   ShmPendingCnt;
+   OS_FdSet  ReadSet;
+   OS_time_t Now;
+   COMM42_Link_t *Link;
+   COMM42_Link_t *ShmLink;
+   
+   while (true)
+   {
+      
+      PendingCnt    = 0;
+      ShmPendingCnt = 0;
+      ShmLink       = NULL;
+      WaitMsec      = OS_PEND;
+      OS_SelectFdZero(&ReadSet);
+      CFE_PSP_GetTime(&Now);
+      
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         
+         Link = &Comm42->Link[i];
+         
+         while (Link->SensorDataRecv && (Link->Replay || ((Link->Wire42.Protocol == WIRE42_PROTOCOL_BINARY) && 
+                ((WIRE42_FramesQueued(&Link->Wire42) > 0) ||
+                 ((Link->Wire42.Shm42 != NULL) && SHM42_Readable(Link->Wire42.Shm42))))))
+         {
+            RecvLinkSensorData(Link, Prefetch);
+         }
+         
+         if (Link->SensorDataRecv && (Comm42->SensorTimeout > 0))
+         {
+            RemainMsec = Comm42->SensorTimeout - OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Now, Link->SensorWaitTime));
+            if (RemainMsec <= 0)
+            {
+               AbortSensorRecv(Link);
+            }
+            else if ((WaitMsec == OS_PEND) || (RemainMsec < WaitMsec))
+            {
+               WaitMsec = (int32)RemainMsec;
+            }
+         }
+         
+         if (Link->SensorDataRecv && Link->Wire42.Datagram && !Link->Replay && 
+             (Link->SensorStepCnt == 0) && (Comm42->UdpResendTimeout > 0))
+         {
+            RemainMsec = ResendActuatorFrame(Link, Now);
+            if ((WaitMsec == OS_PEND) || (RemainMsec < WaitMsec))
+            {
+               WaitMsec = (int32)RemainMsec;
+            }
+         }
+         
+         if (Link->SensorDataRecv)
+         {
+            if (Link->Wire42.Shm42 != NULL)
+            {
+               if (ShmLink == NULL)
+               {
+                  ShmLink = Link;
+               }
+               ++ShmPendingCnt;
+            }
+            else
+            {
+               OS_SelectFdAdd(&ReadSet, Link->SocketId);
+               ++PendingCnt;
+            }
+         }
+      }
+      
+      if (ShmPendingCnt > 0)
+      {
+         if ((PendingCnt > 0) || (ShmPendingCnt > 1))
+         {
+            if ((WaitMsec == OS_PEND) || (WaitMsec > COMM42_SHM_POLL_MSEC))
+            {
+               WaitMsec = COMM42_SHM_POLL_MSEC;
+            }
+         }
+         if (PendingCnt == 0)
+         {
+            SHM42_Wait(ShmLink->Wire42.Shm42, WaitMsec);
+            continue;
+         }
+      }
+      else if (PendingCnt == 0)
+      {
+         break;
+      }
+      
+      Status = OS_SelectMultiple(&ReadSet, NULL, WaitMsec);
+      if (Status == OS_ERROR_TIMEOUT)
+      {
+         continue;
+      }
+      if (Status != OS_SUCCESS)
+      {
+         CFE_EVS_SendEvent(COMM42_SOCKET_TASK_EID, CFE_EVS_EventType_ERROR,
+                           "Closing %d link sockets after OS_SelectMultiple() failed with status %d",
+                           PendingCnt, (int)Status);    
+         for (i=0; i < Comm42->LinkCnt; i++)
+         {
+            if (Comm42->Link[i].SensorDataRecv)
+            {
+               CloseLink(&Comm42->Link[i]);
+            }
+         }
+         break;
+      }
+      
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         Link = &Comm42->Link[i];
+         if (Link->SensorDataRecv && OS_SelectFdIsSet(&ReadSet, Link->SocketId))
+         {
+            RecvLinkSensorData(Link, Prefetch);
+         }
+      }
+   
+   } /* End while pending */
+   
+} /* End RecvSensorData() */
+
+
+/******************************************************************************
+** Function: ResendActuatorFrame
+**
+** Resend a UDP link's last actuator frame each time UdpResendTimeout passes
+** without a sensor frame. Returns the milliseconds until the next resend.
+**
+** Notes:
+**   1. The resend count is derived from the wait time so a child task that
+**      was delayed for several timeouts only resends once.
+**   2. Only a step-by-step exchange that hasn't received a sensor frame is
+**      resent and 42 recognizes the resend by its echoed Seq. A batch
+**      exchange that loses part of its sensor frames is recovered by the
+**      SensorTimeout watchdog.
+*/
+static int64 ResendActuatorFrame(COMM42_Link_t *Link, OS_time_t Now)
+{
+   
+   int64  WaitMsec = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Now, Link->SensorWaitTime));
+   uint16 ResendCnt = (uint16)(WaitMsec / Comm42->UdpResendTimeout);
+   
+   if (ResendCnt > Link->ResendWaitCnt)
+   {
+      Link->ResendWaitCnt = ResendCnt;
+      WIRE42_ResendActuator(&Link->Wire42, Link->SocketId);
+   }
+   
+   return ((int64)Comm42->UdpResendTimeout * (ResendCnt + 1)) - WaitMsec;
+   
+} /* End ResendActuatorFrame() */
+
+
+/******************************************************************************
+** Function: SendActuatorFrame
+**
+** Write a binary link's actuator frame.
+**
+** Notes:
+**   1. A replayed link has no socket so its frames are only consumed.
+**   2. When batching, frames are collected until there is one for each
+**      sensor frame of the exchange. The batch is padded to BatchSteps by
+**      holding the last frame and 42 returns BatchSteps sensor frames. This
+**      trades the closed loop per step for one socket round trip per batch.
+**
+*/
+static void SendActuatorFrame(COMM42_Link_t *Link, const WIRE42_ActuatorFrame_t *ActuatorFrame)
+{
+   
+   uint16 i;
+
+   if (Comm42->BatchSteps > 1)
+   {
+      
+      Link->ActuatorBatch[Link->ActuatorBatchCnt++] = *ActuatorFrame;
+      if (Link->ActuatorBatchCnt < Link->ExchangeSteps)
+      {
+         return;
+      }
+      
+      for (i=Link->ActuatorBatchCnt; i < Comm42->BatchSteps; i++)
+      {
+         Link->ActuatorBatch[i] = *ActuatorFrame;
+      }
+      if (!Link->Replay)
+      {
+         WIRE42_SendActuatorBatch(&Link->Wire42, Link->SocketId, Link->ActuatorBatch, Comm42->BatchSteps);
+      }
+      Link->ActuatorBatchCnt = 0;
+      Link->ExchangeSteps    = Comm42->BatchSteps;
+   
+   }
+   else if (!Link->Replay)
+   {
+      WIRE42_SendActuatorFrame(&Link->Wire42, Link->SocketId, ActuatorFrame);
+   }
+   MarkPhase(Link, PERF42_PHASE_WRITE);
+   
+} /* End SendActuatorFrame() */
+
+
+/******************************************************************************
+** Function: SendSensorDataMsg
+**
+** Publish a link's front sensor data message buffer followed by its compact
+** delta copy, the sensor group messages and the sim tick message that are
+** due. These are sent after the transmit phase is marked so they aren't
+** included in the controller's input latency. The message is tagged with the
+** link's next CycleId for the controller to echo in its actuator command.
+*/
+static void SendSensorDataMsg(COMM42_Link_t *Link)
+{
+   
+   int32 CfeStatus;
+   BC42_INTF_SensorDataMsg_t *SensorDataMsg = &Link->SensorDataMsg[Link->SensorDataMsgFront];
+   COMM42_CycleTag_t *CycleTag;
+   
+   /* Tagged before the transmit so a command can't arrive before its tag */
+   SensorDataMsg->Payload.CycleId = ++Link->CycleId;
+   CycleTag = &Link->CycleTag[Link->CycleId % COMM42_CYCLE_TAG_CNT];
+   CycleTag->CycleId    = Link->CycleId;
+   CycleTag->SensorTime = SensorDataMsg->Payload.GpsTime;
+   CFE_PSP_GetTime(&CycleTag->SendTime);
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader));
+   CfeStatus = CFE_SB_TransmitMsg(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), true);
+   MarkPhase(Link, PERF42_PHASE_TRANSMIT);
+   DELTA42_Send(&Link->Delta42, &SensorDataMsg->Payload);
+   GROUP42_Send(&Link->Group42, &SensorDataMsg->Payload);
+   if (Link->Index == 0)
+   {
+      UpdateSimTime(SensorDataMsg->Payload.GpsTime);
+   }
+   
+   if (CfeStatus == CFE_SUCCESS)
+   {
+      ++Comm42->SensorDataMsgCnt;
+      Link->ActuatorCmdMsgSent   = false;
+      Link->ActuatorCmdWait      = true;
+      Comm42->ActuatorCmdMsgSent = false;
+   }
+   BC42_INTF_CYCLE_EVENT(COMM42_SOCKET_TASK_EID, CFE_EVS_EventType_INFORMATION,
+                         "Sent link %d sensor data message: cFEStatus=%d, InitCycle= %d, ExecuteCycleCnt=%d, Comm42->SensorDataMsgCnt=%d",
+                         Link->Index, CfeStatus, Comm42->InitCycle, Comm42->ExecuteCycleCnt, Comm42->SensorDataMsgCnt);  
+   
+} /* End SendSensorDataMsg() */
+
+
+/******************************************************************************
+** Function: SensorFrameToAcVar
+**
+** Notes:
+**   1. The caller must hold the AcVar lock.
+**
+*/
+static void SensorFrameToAcVar(const WIRE42_SensorFrame_t *SensorFrame)
+{
+   
+   int i;
+   
+   AC42_(Time)     = SensorFrame->Time;
+   AC42_(SunValid) = SensorFrame->SunValid;
+   for (i=0; i < 3; i++)
+   {
+      AC42_(PosN[i]) = SensorFrame->PosN[i];
+      AC42_(VelN[i]) = SensorFrame->VelN[i];
+      AC42_(wbn[i])  = SensorFrame->wbn[i];
+      AC42_(svb[i])  = SensorFrame->svb[i];
+      AC42_(bvb[i])  = SensorFrame->bvb[i];
+   }
+   for (i=0; i < 4; i++)
+   {
+      AC42_(qbn[i])   = SensorFrame->qbn[i];
+      AC42_(Whl[i].H) = SensorFrame->WhlH[i];
+   }
+   
+} /* End SensorFrameToAcVar() */
+
+
+/******************************************************************************
+** Function: ServiceCheckpoint
+**
+** Serve a pending checkpoint request at a cycle boundary, when no link is
+** waiting for an actuator command or receiving sensor data, so a checkpoint
+** is never taken or applied part way through a cycle.
+**
+** Notes:
+**   1. The request is cleared whether or not it succeeds so a failed request
+**      doesn't block later commands.
+**   2. A restore resets each link's delta and group state so the next
+**      messages are keyframes relative to the restored data.
+**   3. A restore re-anchors each link's cycle tags on the restored message.
+**      The checkpoint was taken at a cycle boundary so that message is
+**      answered and a command echoing a cycle published before the restore is
+**      rejected.
+**   4. The 42 connections are kept. Their frame sequence state isn't part of
+**      a checkpoint.
+*/
+static void ServiceCheckpoint(void)
+{
+   
+   int  i;
+   bool AcVarLoaded;
+   CKPT42_Class_t      *Ckpt42 = &Comm42->Ckpt42;
+   CKPT42_Checkpoint_t *Checkpoint = &Ckpt42->Checkpoint;
+   COMM42_Link_t       *Link;
+   
+   if ((Ckpt42->Request == CKPT42_REQUEST_NONE) || !CycleBoundary())
+   {
+      return;
+   }
+   
+   if (Ckpt42->Request == CKPT42_REQUEST_SAVE)
+   {
+      
+      CFE_PSP_MemSet((void*)Checkpoint, 0, sizeof(CKPT42_Checkpoint_t));
+      Checkpoint->ExecuteCycleCnt   = Comm42->ExecuteCycleCnt;
+      Checkpoint->SensorDataMsgCnt  = Comm42->SensorDataMsgCnt;
+      Checkpoint->ActuatorCmdMsgCnt = Comm42->ActuatorCmdMsgCnt;
+      Checkpoint->SimTime      = Comm42->SimTime;
+      Checkpoint->SimTimeValid = Comm42->SimTimeValid;
+      Checkpoint->InitCycle    = Comm42->InitCycle;
+      Checkpoint->LinkCnt      = Comm42->LinkCnt;
+      Checkpoint->SensorMask   = Comm42->SensorMask;
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         Link = &Comm42->Link[i];
+         Checkpoint->SensorData[i] = Link->SensorDataMsg[Link->SensorDataMsgFront].Payload;
+      }
+      
+      Comm42->Bc42 = BC42_TakePtr();
+      CKPT42_SaveAcVar(Ckpt42, AC42);
+      BC42_GivePtr(Comm42->Bc42);
+      
+      if (CKPT42_Write(Ckpt42, Ckpt42->Filename))
+      {
+         ++Ckpt42->SaveCnt;
+         CFE_EVS_SendEvent(COMM42_CHECKPOINT_EID, CFE_EVS_EventType_INFORMATION,
+                           "Saved checkpoint %s at cycle %d, sim time %.3f",
+                           Ckpt42->Filename, Checkpoint->ExecuteCycleCnt, Checkpoint->SimTime);
+      }
+   
+   } /* End if save */
+   else
+   {
+      
+      Comm42->Bc42 = BC42_TakePtr();
+      AcVarLoaded = CKPT42_LoadAcVar(Ckpt42, AC42);
+      BC42_GivePtr(Comm42->Bc42);
+      
+      if (AcVarLoaded)
+      {
+         
+         Comm42->ExecuteCycleCnt   = Checkpoint->ExecuteCycleCnt;
+         Comm42->FreeRunCycleCnt   = Checkpoint->ExecuteCycleCnt;
+         Comm42->SensorDataMsgCnt  = Checkpoint->SensorDataMsgCnt;
+         Comm42->ActuatorCmdMsgCnt = Checkpoint->ActuatorCmdMsgCnt;
+         Comm42->SimTime         = Checkpoint->SimTime;
+         Comm42->SimTimeValid    = Checkpoint->SimTimeValid;
+         Comm42->SimPaceAnchored = false;
+         Comm42->InitCycle       = Checkpoint->InitCycle;
+         Comm42->SensorMask      = Checkpoint->SensorMask;
+         for (i=0; i < Comm42->LinkCnt; i++)
+         {
+            Link = &Comm42->Link[i];
+            Link->Wire42.SensorMask = Checkpoint->SensorMask;
+            Link->SensorDataMsg[Link->SensorDataMsgFront].Payload = Checkpoint->SensorData[i];
+            Link->CycleId         = Checkpoint->SensorData[i].CycleId;
+            Link->AnsweredCycleId = Link->CycleId;
+            CFE_PSP_MemSet((void*)Link->CycleTag, 0, sizeof(Link->CycleTag));
+            DELTA42_Reset(&Link->Delta42);
+            GROUP42_Reset(&Link->Group42);
+         }
+         
+         ++Ckpt42->RestoreCnt;
+         CFE_EVS_SendEvent(COMM42_CHECKPOINT_EID, CFE_EVS_EventType_INFORMATION,
+                           "Restored checkpoint %s at cycle %d, sim time %.3f",
+                           Ckpt42->Filename, Comm42->ExecuteCycleCnt, Comm42->SimTime);
+      }
+   
+   } /* End if restore */
+   
+   Ckpt42->Request = CKPT42_REQUEST_NONE;
+   
+} /* End ServiceCheckpoint() */
+
+
+/******************************************************************************
+** Function: ServiceRequests
+**
+** Serve the parent's pending requests at the start of the child's pass,
+** when it isn't reading any link.
+**
+** Notes:
+**   1. Links are only opened and closed by the child so a socket or shared
+**      memory segment is never released under a read. A close isn't held for
+**      a cycle boundary because a link waiting on a stalled controller would
+**      never reach one.
+**   2. Replay and record requests are served here so the replay link state
+**      and the recording file are only changed by the child, which reads the
+**      links and writes the records.
+**   3. Replayed links use the binary protocol path so the first link's frames
+**      are copied into AcVar and actuator frames are consumed without a
+**      socket write.
+**   4. A PERF42 reset request doesn't give the semaphore since it only has to
+**      precede the child's next mark.
+*/
+static void ServiceRequests(void)
+{
+   
+   int i;
+   COMM42_Link_t *Link;
+   
+   if (Comm42->CloseRequest)
+   {
+      Comm42->CloseRequest = false;
+      CloseLinks();
+   }
+   
+   if (Comm42->ReplayRequest)
+   {
+      
+      Comm42->ReplayRequest = false;
+      CloseLinks();
+      
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         
+         Link = &Comm42->Link[i];
+         
+         if (REC42_OpenReplay(&Link->Replay42, Comm42->ReplayFile))
+         {
+            Link->Replay = true;
+            Link->SocketConnected    = true;
+            Link->Wire42.Protocol    = WIRE42_PROTOCOL_BINARY;
+            Link->ActuatorCmdMsgSent = false;
+            Link->ActuatorCmdWait    = false;
+            Link->SensorDataRecv     = false;
+            Link->PrefetchPending    = false;
+            Link->PrefetchReady      = false;
+            Link->ExchangeSteps      = 1;
+            Link->SensorStepCnt      = 0;
+            Link->ActuatorStepCnt    = 0;
+            Link->ActuatorBatchCnt   = 0;
+            Comm42->SocketConnected  = true;
+            Link->AnsweredCycleId    = Link->CycleId;
+            DELTA42_Reset(&Link->Delta42);
+            GROUP42_Reset(&Link->Group42);
+         }
+      }
+      
+      if (Comm42->SocketConnected)
+      {
+         Comm42->InitCycle = true;
+         Comm42->ActuatorCmdMsgSent = false;
+         Comm42->CyclePending = true;
+      }
+   
+   } /* End if replay request */
+   
+   if (Comm42->ConnectRequest)
+   {
+      
+      Comm42->ConnectRequest = false;
+      
+      strncpy(Comm42->IpAddrStr, Comm42->ConnectAddrStr, sizeof(Comm42->IpAddrStr));
+      Comm42->IpAddrStr[sizeof(Comm42->IpAddrStr)-1] = '\0';
+      Comm42->Port         = Comm42->ConnectPort;
+      Comm42->Link[0].Port = Comm42->ConnectPort;
+      Comm42->Transport    = Comm42->ConnectTransport;
+      
+      for (i=0; i < Comm42->LinkCnt; i++)
+      {
+         Comm42->Link[i].ConnectBackoff = 0;
+         CFE_PSP_GetTime(&Comm42->Link[i].ConnectTime);
+      }
+      
+      Comm42->AutoConnect = true;
+   
+   } /* End if connect request */
+   
+   if (Comm42->RecordRequest == COMM42_RECORD_REQUEST_START)
+   {
+      REC42_OpenRecord(&Comm42->Rec42, Comm42->RecordRequestFile);
+   }
+   else if (Comm42->RecordRequest == COMM42_RECORD_REQUEST_STOP)
+   {
+      REC42_Close(&Comm42->Rec42);
+   }
+   Comm42->RecordRequest = COMM42_RECORD_REQUEST_NONE;
+   
+   if (Comm42->PerfResetRequest)
+   {
+      Comm42->PerfResetRequest = false;
+      PERF42_ResetStatus(&Comm42->Perf42);
+   }
+   
+} /* End ServiceRequests() */
+
+
+/******************************************************************************
+** Function: SimPaceWaitMsec
+**
+** Return the milliseconds until a pending free running cycle can start
+** without the sim time, the first link's sensor frame time, getting ahead
+** of SimRate. Returns zero when the cycle can start or isn't paced.
+**
+** Notes:
+**   1. The schedule's anchor is taken by the first paced cycle, which
+**      starts immediately.
+**   2. The anchor is retaken when the sim time moves backwards or the
+**      schedule is off by more than COMM42_SIM_PACE_RESYNC_MSEC, so a 42
+**      restart doesn't stall the cycles and a slow stretch isn't followed by
+**      a burst.
+*/
+static uint32 SimPaceWaitMsec(void)
+{
+
+   OS_time_t Now;
+   int64     SimMsec;
+   int64     WallMsec;
+   uint32    WaitMsec = 0;
+   
+   if (Comm42->FreeRun && Comm42->CyclePending && (Comm42->SimRate > 0) && Comm42->SimTimeValid)
+   {
+      
+      CFE_PSP_GetTime(&Now);
+      
+      if (Comm42->SimPaceAnchored)
+      {
+         
+         SimMsec  = (int64)((Comm42->SimTime - Comm42->SimPaceAnchorTime)*1000.0/Comm42->SimRate);
+         WallMsec = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Now, Comm42->SimPaceAnchorWall));
+         
+         if ((SimMsec < 0) || ((SimMsec - WallMsec) > COMM42_SIM_PACE_RESYNC_MSEC) ||
+             ((WallMsec - SimMsec) > COMM42_SIM_PACE_RESYNC_MSEC))
+         {
+            Comm42->SimPaceAnchored = false;
+         }
+         else if (SimMsec > WallMsec)
+         {
+            WaitMsec = (uint32)(SimMsec - WallMsec);
+         }
+      }
+      
+      if (!Comm42->SimPaceAnchored)
+      {
+         Comm42->SimPaceAnchorTime = Comm42->SimTime;
+         Comm42->SimPaceAnchorWall = Now;
+         Comm42->SimPaceAnchored   = true;
+      }
+      
+   } /* End if paced cycle pending */
+   
+   return WaitMsec;
+   
+} /* End SimPaceWaitMsec() */
+
+
+/******************************************************************************
+** Function: StartSensorRecv
+**
+** Start receiving a link's sensor data and its watchdog.
+*/
+static void StartSensorRecv(COMM42_Link_t *Link)
+{
+   
+   Link->SensorDataRecv = true;
+   Link->ResendWaitCnt  = 0;
+   CFE_PSP_GetTime(&Link->SensorWaitTime);
+   MarkPhase(Link, PERF42_PHASE_WAKEUP);
+   
+} /* End StartSensorRecv() */
+
+
+/******************************************************************************
+** Function: UpdateSimTime
+**
+** Save the first link's sensor data message time and publish the sim tick
+** message when the time enters a new SimTickPeriod so downstream apps can
+** schedule from the sim clock. A zero SimTickPeriod disables the tick.
+**
+** Notes:
+**   1. A tick is published for the first sensor data message and for any
+**      change of tick period so a 42 restart produces a tick.
+*/
+static void UpdateSimTime(double SimTime)
+{
+
+   int64 TickIndex;
+   
+   Comm42->SimTime      = SimTime;
+   Comm42->SimTimeValid = true;
+   
+   if (Comm42->SimTickPeriod > 0)
+   {
+      
+      TickIndex = (int64)(SimTime*1000.0/Comm42->SimTickPeriod);
+      if (!Comm42->SimTickValid || (TickIndex != Comm42->SimTickIndex))
+      {
+         
+         Comm42->SimTickValid = true;
+         Comm42->SimTickIndex = TickIndex;
+         
+         Comm42->SimTickMsg.Payload.SimTime = SimTime;
+         ++Comm42->SimTickMsg.Payload.TickCnt;
+         CFE_SB_TimeStampMsg(CFE_MSG_PTR(Comm42->SimTickMsg.TelemetryHeader));
+         CFE_SB_TransmitMsg(CFE_MSG_PTR(Comm42->SimTickMsg.TelemetryHeader), true);
+      
+      }
+   } /* End if sim tick enabled */
+   
+} /* End UpdateSimTime() */
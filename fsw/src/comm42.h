@@ -25,6 +25,12 @@
 **       sensors and actuators so BC42_INTF_APP's functionality may be 
 **       distributed. Even with multiple interface apps, having a single app to
 **       aggregate and synchronize sensor data is often helpful.
+**    4. Up to COMM42_LINK_MAX 42 spacecraft links are serviced by one child
+**       task, which performs the link I/O, the connections and the actuator
+**       command processing. Only the first link is mirrored in AcVar.
+**    5. Binary frames are read and written without BC42_LIB's AcVar lock.
+**       The ASCII records are formatted and parsed directly in AcVar so only
+**       the first link may use them and its I/O holds the lock.
 **
 */
 #ifndef _comm42_
@@ -36,6 +42,13 @@
 
 #include "app_cfg.h"
 #include "bc42.h"
+#include "ckpt42.h"
+#include "delta42.h"
+#include "group42.h"
+#include "perf42.h"
+#include "rec42.h"
+#include "trace42.h"
+#include "wire42.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -43,6 +56,32 @@
 
 #define COMM42_SEM_INVALID      0xFFFFFFFF
 
+#define COMM42_SENSOR_BUF_CNT   2   /* Sensor data message double buffer */
+
+#define COMM42_LINK_MAX     4   /* Must agree with the ini file's link definitions */
+#define COMM42_LINK_UNDEF   0xFFFF
+
+#define COMM42_TRANSPORT_SOCKET_STR  "SOCKET"
+#define COMM42_TRANSPORT_SHM_STR     "SHM"
+#define COMM42_TRANSPORT_UDP_STR     "UDP"
+
+#define COMM42_SHM_POLL_MSEC  1   /* Doorbell wait limit while multiple shared memory links are pending */
+
+#define COMM42_SIM_PACE_RESYNC_MSEC  5000   /* Sim pacing schedule error that retakes the anchor */
+
+#define COMM42_CYCLE_TAG_CNT  WIRE42_BATCH_MAX   /* Published cycles that can be answered */
+
+/*
+** Cycle trace record identifiers. PERF42 phases are recorded using their
+** PERF42_Phase_t value with the link index in Arg0.
+*/
+
+#define COMM42_TRACE_CYCLE_START    16   /* Arg0: UnclosedCycleCnt */
+#define COMM42_TRACE_UNCLOSED       17   /* Arg0: UnclosedCycleCnt */
+#define COMM42_TRACE_SOCKET_CLOSE   18   /* Arg0: Link index */
+#define COMM42_TRACE_SOCKET_CONNECT 19   /* Arg0: Link index */
+#define COMM42_TRACE_SENSOR_STALL   20   /* Arg0: Link index */
+
 /*
 ** Event Message IDs
 */
@@ -55,27 +94,132 @@
 #define COMM42_SKIP_INIT_CYCLE_EID  (COMM42_BASE_EID + 5)
 #define COMM42_NO_ACTUATOR_CMD_EID  (COMM42_BASE_EID + 6)
 #define COMM42_DEBUG_EID            (COMM42_BASE_EID + 7)
+#define COMM42_LINK_CONFIG_EID      (COMM42_BASE_EID + 9)
+#define COMM42_RECONNECT_EID        (COMM42_BASE_EID + 10)
+#define COMM42_BATCH_CONFIG_EID     (COMM42_BASE_EID + 11)
+#define COMM42_SENSOR_MASK_EID      (COMM42_BASE_EID + 12)
+#define COMM42_ACTUATOR_PIPE_EID    (COMM42_BASE_EID + 13)
+#define COMM42_WATCHDOG_EID         (COMM42_BASE_EID + 14)
+#define COMM42_TRANSPORT_EID        (COMM42_BASE_EID + 15)
+#define COMM42_CHECKPOINT_EID       (COMM42_BASE_EID + 16)
+#define COMM42_CYCLE_TAG_EID        (COMM42_BASE_EID + 17)
+#define COMM42_RECORD_EID           (COMM42_BASE_EID + 18)
+#define COMM42_ACTUATOR_LEN_EID     (COMM42_BASE_EID + 19)
 
 
 /**********************/
 /** Type Definitions **/
 /**********************/
 
+
+/*
+** Values must agree with the EDS Transport definitions
+*/
+typedef enum
+{
+
+   COMM42_TRANSPORT_SOCKET = 1,
+   COMM42_TRANSPORT_SHM    = 2,
+   COMM42_TRANSPORT_UDP    = 3
+
+} COMM42_Transport_t;
+
+
+typedef enum
+{
+
+   COMM42_RECORD_REQUEST_NONE  = 0,
+   COMM42_RECORD_REQUEST_START = 1,
+   COMM42_RECORD_REQUEST_STOP  = 2
+
+} COMM42_RecordRequest_t;
+
+
 /******************************************************************************
-** Commands
-** - See EDS command definitions in bc42_intf.xml
+** Published sensor data message that a tagged actuator command can answer
 */
 
+typedef struct
+{
+
+   uint32     CycleId;
+   double     SensorTime;    /* Message's GpsTime */
+   OS_time_t  SendTime;
+
+} COMM42_CycleTag_t;
+
 
 /******************************************************************************
-** Telemetry
-** - See EDS telemetry definitions in bc42_intf.xml
+** Spacecraft Link
 */
 
+typedef struct
+{
+
+   uint16  Index;
+   
+   bool           SocketConnected;
+   osal_id_t      SocketId;
+   OS_SockAddr_t  SocketAddr;
+   uint16         Port;
+   
+   SHM42_Class_t  Shm42;         /* Used by the shared memory transport */
+   char           ShmName[SHM42_NAME_LEN];
+   
+   uint32     ConnectBackoff;    /* Milliseconds between failed connection attempts */
+   OS_time_t  ConnectTime;       /* Earliest time of the next connection attempt */
+   
+   bool    ActuatorCmdMsgSent;   /* Used for each control cycle */
+   bool    SensorDataRecv;       /* Child task is receiving the link's sensor data */
+   bool    PrefetchPending;      /* Set when the link's cycle closes to have the child prefetch */
+   bool    PrefetchReady;        /* Back sensor data message buffer holds the next cycle's data */
+   bool    ActuatorCmdWait;      /* Sensor data published, waiting for the exchange's actuator commands */
+   
+   OS_time_t  SensorWaitTime;    /* Start of the sensor data wait or the last sensor frame received */
+   uint16     SensorStallCnt;    /* Sensor data waits aborted by the watchdog */
+   uint16     ResendWaitCnt;     /* UDP actuator resends during the current sensor data wait */
+   
+   bool       ActuatorCmdLatched;      /* ActuatorCmdLatest holds the newest drained command */
+   uint16     ActuatorStaleCnt;        /* Commands dropped because the link wasn't waiting */
+   uint16     ActuatorSupersededCnt;   /* Commands replaced by a newer queued command */
+   uint16     ActuatorLenErrCnt;       /* Commands dropped because their length was wrong */
+   BC42_INTF_ActuatorCmdMsg_t ActuatorCmdLatest;
+   
+   uint32  CycleId;               /* Last published sensor data message */
+   uint32  AnsweredCycleId;       /* Last cycle answered by a tagged actuator command */
+   uint16  CycleLostCnt;          /* Cycles skipped by an answered cycle */
+   uint16  CycleLateCnt;          /* Commands rejected for an answered or earlier exchange's cycle */
+   uint16  CycleMismatchCnt;      /* Commands rejected for an unpublished cycle or sensor time */
+   uint32  CycleLatencyUsec;      /* Last tagged cycle's send to command received time */
+   uint32  CycleLatencyMaxUsec;
+   COMM42_CycleTag_t CycleTag[COMM42_CYCLE_TAG_CNT];   /* Indexed by CycleId modulo the count */
+   
+   uint16  ExchangeSteps;        /* Sensor frames 42 returns for the last actuator frame written */
+   uint16  SensorStepCnt;        /* Child task, sensor frames received in the current exchange */
+   uint16  ActuatorStepCnt;      /* Child task, actuator commands received for the current exchange */
+   uint16  ActuatorBatchCnt;     /* Child task, actuator commands in ActuatorBatch */
+   WIRE42_ActuatorFrame_t ActuatorBatch[WIRE42_BATCH_MAX];
+   
+   CFE_SB_MsgId_t  ActuatorCmdMsgMid;
+
+   bool            Replay;      /* Sensor frames are read from Replay42 rather than the socket */
+   REC42_Class_t   Replay42;
+   
+   WIRE42_Class_t  Wire42;
+   
+   uint8  SensorDataMsgFront;  /* Index of the buffer being published */
+   BC42_INTF_SensorDataMsg_t SensorDataMsg[COMM42_SENSOR_BUF_CNT];
+   
+   DELTA42_Class_t Delta42;     /* Compact copy of each published sensor data message */
+   GROUP42_Class_t Group42;     /* Decimated per sensor group messages */
+   
+} COMM42_Link_t;
+
 
 /******************************************************************************
 ** COMM42 Class
 */
+
 typedef struct
 {
 
@@ -88,34 +232,87 @@ typedef struct
    uint32  WakeUpSemaphore;
    
    bool    InitCycle;
-   bool    ActuatorCmdMsgSent;   /* Used for each control cycle */
-   uint32  SensorDataMsgCnt;
+   bool    ActuatorCmdMsgSent;   /* All connected links have sent the current cycle's actuator command */
+   uint32  SensorDataMsgCnt;     /* Totals for all links */
    uint32  ActuatorCmdMsgCnt;
    uint32  ExecuteCycleCnt;
    uint16  UnclosedCycleCnt;    /* 'Unclosed' is when ManageExecution() called but sensor-ctrl-actuator cycle didn't finish */ 
    uint16  UnclosedCycleLim;
    
-   bool           SocketConnected;
-   osal_id_t      SocketId;
-   OS_SockAddr_t  SocketAddr;
+   bool    FreeRun;             /* Start the next cycle as soon as an actuator command closes the current cycle */
+   uint32  FreeRunCycleCnt;     /* ExecuteCycleCnt at the previous ManageExecution() call */
+   
+   uint16     SimRate;             /* Free running sim seconds per wall clock second, 0 is unpaced */
+   bool       SimTimeValid;
+   double     SimTime;             /* 42 time of the first link's latest sensor data message */
+   bool       SimPaceAnchored;
+   double     SimPaceAnchorTime;   /* Sim and wall clock times the pacing schedule is measured from */
+   OS_time_t  SimPaceAnchorWall;
+   
+   uint32  SimTickPeriod;       /* Sim milliseconds between sim tick messages, 0 disables */
+   bool    SimTickValid;
+   int64   SimTickIndex;        /* Sim tick period of the previous sim tick message */
+   BC42_INTF_SimTickMsg_t SimTickMsg;
+   
+   bool    SensorPrefetch;      /* Receive the next sensor data as soon as an actuator command closes a link's cycle */
+   bool    CyclePending;        /* Set by the parent's execute or a closing actuator command to start a cycle */
+   
+   CFE_SB_PipeId_t  ActuatorPipe;          /* All links' actuator command messages, serviced by the child */
+   int32            ActuatorPipeTimeout;   /* Milliseconds, limits each child wait on the pipe */
+   
+   uint32  ChildWaitTimeout;    /* Milliseconds, limits each child semaphore wait, 0 waits forever */
+   uint32  SensorTimeout;       /* Milliseconds without sensor data before a link is aborted, 0 waits forever */
+   uint16  SensorStallCnt;      /* Sensor data waits aborted by the watchdog, all links */
+   uint32  UdpResendTimeout;    /* Milliseconds without a sensor datagram before the actuator datagram is resent, 0 disables */
+   
+   uint16  BatchSteps;          /* Simulation steps per 42 exchange, 1 closes the loop every step */
+   uint16  SensorMask;          /* WIRE42_SENSOR_x groups that are decoded and processed */
+   
+   bool    SocketConnected;     /* At least one link is connected */
+   bool    AutoConnect;         /* Child task connects disconnected links */
+   uint16  ConnectCnt;          /* Successful link connections including reconnections */
    
    // 42 Socket Data
    SOCKET  SocketFd;
    char    IpAddrStr[16];
    uint16  Port;
    
-   /*
-   ** Contained Objects
-   */
+   bool    CloseRequest;        /* Set by parent to have the child close the links */
+   bool    ConnectRequest;      /* Set by parent to have the child connect using the Connect fields */
+   char    ConnectAddrStr[16];
+   uint16  ConnectPort;
+   COMM42_Transport_t ConnectTransport;
+   bool    ReplayRequest;       /* Set by parent to have the child close the links and replay ReplayFile */
+   char    ReplayFile[OS_MAX_PATH_LEN];
+   COMM42_RecordRequest_t RecordRequest;   /* Set by parent, cleared by the child when it's served */
+   char    RecordRequestFile[OS_MAX_PATH_LEN];
+   bool    PerfResetRequest;    /* Set by parent to have the child reset Perf42 */
+   
+   int32   ConnectTimeout;      /* Milliseconds, a single connection attempt */
+   uint32  ConnectBackoffMin;   /* Milliseconds, first retry delay after a failure */
+   uint32  ConnectBackoffMax;   /* Milliseconds, retry delay limit */
+   
+   WIRE42_Protocol_t WireProtocolCfg;   /* Requested protocol, each link's Wire42.Protocol is the negotiated protocol */
+   COMM42_Transport_t TransportCfg;     /* Ini file transport */
+   COMM42_Transport_t Transport;        /* Transport used by the current connect request */
+   int32             WireHelloTimeout;
    
-   BC42_Class_t *Bc42;
+   char  TraceFile[OS_MAX_PATH_LEN];   /* Default dump file */
+   char  RecordFile[OS_MAX_PATH_LEN];  /* Default record and replay file */
+   char  CheckpointFile[OS_MAX_PATH_LEN];   /* Default checkpoint file */
    
    /*
-   ** Telemetry
+   ** Contained Objects
    */
    
-   BC42_INTF_SensorDataMsg_t SensorDataMsg;
-
+   BC42_Class_t    *Bc42;
+   PERF42_Class_t  Perf42;      /* Times the first link's cycle */
+   TRACE42_Class_t Trace42;
+   REC42_Class_t   Rec42;       /* Records all links */
+   CKPT42_Class_t  Ckpt42;
+   
+   uint16         LinkCnt;
+   COMM42_Link_t  Link[COMM42_LINK_MAX];
    
 } COMM42_Class_t;
 
@@ -138,6 +335,8 @@ void COMM42_Constructor(COMM42_Class_t *Bc42Intf, const INITBL_Class_t *IniTbl);
 /******************************************************************************
 ** Function: COMM42_Close
 **
+** Request the child task to close all of the links and stop automatic
+** connections.
 */
 void COMM42_Close(void);
 
@@ -145,23 +344,46 @@ void COMM42_Close(void);
 /******************************************************************************
 ** Function:  COMM42_ConnectSocket
 **
+** Request the child task to connect each link using Transport. Port is used
+** for the first link and the other links use their ini file ports.
+**
+** Notes:
+**   1. This function doesn't wait for the connections. The child task keeps
+**      connecting disconnected links until COMM42_Close() is called. A
+**      pending close request is served before the connect request.
+**   2. The socket transport is used if Transport requires the binary
+**      protocol and it isn't configured.
+**
 */
-bool COMM42_ConnectSocket(const char *AddrStr, uint32 Port);
+void COMM42_ConnectSocket(const char *AddrStr, uint32 Port, COMM42_Transport_t Transport);
 
 
 /******************************************************************************
-** Function:  COMM42_ManageExecution
+** Function: COMM42_DumpTraceCmd
 **
+** Write the cycle trace to a file.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+**   2. The ini file's default file is used if the command's filename is empty.
 */
-void COMM42_ManageExecution(void);
+bool COMM42_DumpTraceCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: COMM42_GetActuatorCmdLink
+**
+** Return the index of the link that receives actuator commands with MsgId or
+** COMM42_LINK_UNDEF if no link uses MsgId.
+*/
+uint16 COMM42_GetActuatorCmdLink(CFE_SB_MsgId_t MsgId);
 
 
 /******************************************************************************
-** Function: COMM42_RecvSensorData
+** Function:  COMM42_ManageExecution
 **
-** Read sensor data from 42 socket and load process sensor data packet.
 */
-bool COMM42_RecvSensorData(BC42_INTF_SensorDataMsg_t *SensorDataMsg);
+void COMM42_ManageExecution(void);
 
 
 /******************************************************************************
@@ -171,12 +393,70 @@ bool COMM42_RecvSensorData(BC42_INTF_SensorDataMsg_t *SensorDataMsg);
 void COMM42_ResetStatus(void);
 
 
+/******************************************************************************
+** Function: COMM42_RestoreCheckpointCmd
+**
+** Restore AcVar and the cycle state from a checkpoint file at the next cycle
+** boundary.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+**   2. The ini file's default file is used if the command's filename is empty.
+**   3. The file is read and validated by the command so a bad file is
+**      rejected without changing any state.
+*/
+bool COMM42_RestoreCheckpointCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: COMM42_SaveCheckpointCmd
+**
+** Save AcVar and the cycle state to a checkpoint file at the next cycle
+** boundary.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+**   2. The ini file's default file is used if the command's filename is empty.
+*/
+bool COMM42_SaveCheckpointCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Function: COMM42_SendActuatorCmds
 **
-** Send actuator commandd data to 42.
+** Send actuator commandd data to 42. Returns false if a tagged command is
+** rejected. Must only be called by the child task, which receives the
+** actuator commands.
+*/
+bool COMM42_SendActuatorCmds(uint16 LinkIndex, const BC42_INTF_ActuatorCmdMsg_t *ActuatorCmdMsg); 
+
+
+/******************************************************************************
+** Function: COMM42_SetSensorMaskCmd
+**
+** Select the sensors that are decoded, processed and reported as valid.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+*/
+bool COMM42_SetSensorMaskCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: COMM42_SetFreeRun
+**
+** Enable or disable starting a new cycle as soon as the current cycle closes.
+*/
+void COMM42_SetFreeRun(bool FreeRun); 
+
+
+/******************************************************************************
+** Function: COMM42_SetSimRate
+**
+** Set the free running sim seconds per wall clock second, zero disables the
+** pacing and cycles run as fast as 42 and the controller allow.
 */
-bool COMM42_SendActuatorCmds(const BC42_INTF_ActuatorCmdMsg_t *ActuatorCmdMsg); 
+void COMM42_SetSimRate(uint16 SimRate); 
 
 
 /******************************************************************************
@@ -197,4 +477,56 @@ void COMM42_Shutdown(void);
 bool COMM42_SocketTask(CHILDMGR_Class_t* ChildMgr);
 
 
+/******************************************************************************
+** Function: COMM42_StartRecordCmd
+**
+** Request the child task to record the sensor and actuator frames of every
+** link to a file.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+**   2. The ini file's default file is used if the command's filename is empty.
+**   3. The command is rejected while a record request is pending.
+*/
+bool COMM42_StartRecordCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: COMM42_StartReplayCmd
+**
+** Request the child task to close the links and replay a recording's
+** sensor frames in place of 42.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+**   2. The ini file's default file is used if the command's filename is empty.
+**   3. A disconnect command stops the replay. Each link stops when its
+**      recorded sensor frames are exhausted. Replayed sensor data is always
+**      ready so in free running mode the cycle rate is limited only by the
+**      controller.
+**   4. The command is rejected while a replay request is pending.
+*/
+bool COMM42_StartReplayCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: COMM42_StopRecordCmd
+**
+** Request the child task to close the recording file.
+**
+** Notes:
+**   1. Must match CMDMGR_CmdFuncPtr function signature
+**   2. The command is rejected while a record request is pending.
+*/
+bool COMM42_StopRecordCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: COMM42_TransportStr
+**
+** Return a transport's ini file string.
+*/
+const char *COMM42_TransportStr(COMM42_Transport_t Transport);
+
+
 #endif /* _comm42_ */
@@ -0,0 +1,165 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Publish a compact delta encoded copy of a link's sensor data message
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "delta42.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool PackField(DELTA42_Class_t *Delta42, uint16 PrevIndex, const double *Vec, uint16 Len,
+                      bool KeyFrame, uint16 *DataLen);
+
+
+/******************************************************************************
+** Function: DELTA42_Constructor
+**
+*/
+void DELTA42_Constructor(DELTA42_Class_t *Delta42, bool Enabled, CFE_SB_MsgId_t MsgId,
+                         uint8 Link, uint16 KeyFrameCycles)
+{
+
+   CFE_PSP_MemSet((void*)Delta42, 0, sizeof(DELTA42_Class_t));
+
+   Delta42->Enabled        = Enabled;
+   Delta42->KeyFrameCycles = KeyFrameCycles;
+
+   CFE_MSG_Init(CFE_MSG_PTR(Delta42->SensorDeltaMsg.TelemetryHeader), MsgId,
+                sizeof(BC42_INTF_SensorDeltaMsg_t));
+   Delta42->SensorDeltaMsg.Payload.Link = Link;
+
+   DELTA42_Reset(Delta42);
+
+} /* End DELTA42_Constructor() */
+
+
+/******************************************************************************
+** Function: DELTA42_Reset
+**
+*/
+void DELTA42_Reset(DELTA42_Class_t *Delta42)
+{
+
+   Delta42->KeyFrameCnt = Delta42->KeyFrameCycles;
+
+} /* End DELTA42_Reset() */
+
+
+/******************************************************************************
+** Function: DELTA42_Send
+**
+** Notes:
+**   1. Each field's Prev[] index is fixed so a suppressed field keeps its
+**      last sent value.
+**
+*/
+uint16 DELTA42_Send(DELTA42_Class_t *Delta42, const BC42_INTF_SensorDataMsg_Payload_t *SensorData)
+{
+
+   BC42_INTF_SensorDeltaMsg_Payload_t *Delta = &Delta42->SensorDeltaMsg.Payload;
+   bool   KeyFrame;
+   uint16 DataLen  = 0;
+   uint16 FieldCnt = 0;
+   uint8  FieldMask = 0;
+
+   if (!Delta42->Enabled)
+   {
+      return 0;
+   }
+
+   KeyFrame = (Delta42->KeyFrameCnt >= Delta42->KeyFrameCycles);
+   Delta42->KeyFrameCnt = KeyFrame ? 0 : (Delta42->KeyFrameCnt + 1);
+
+   if (PackField(Delta42,  0, SensorData->PosN, 3, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_POSN;
+   if (PackField(Delta42,  3, SensorData->VelN, 3, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_VELN;
+   if (PackField(Delta42,  6, SensorData->qbn,  4, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_QBN;
+   if (PackField(Delta42, 10, SensorData->wbn,  3, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_WBN;
+   if (PackField(Delta42, 13, SensorData->svb,  3, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_SVB;
+   if (PackField(Delta42, 16, SensorData->bvb,  3, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_BVB;
+   if (PackField(Delta42, 19, SensorData->WhlH, 4, KeyFrame, &DataLen)) FieldMask |= DELTA42_FIELD_WHLH;
+
+   Delta->GpsTime    = SensorData->GpsTime;
+   Delta->FieldMask  = FieldMask;
+   Delta->KeyFrame   = KeyFrame;
+   Delta->GpsValid   = SensorData->GpsValid;
+   Delta->StValid    = SensorData->StValid;
+   Delta->SunValid   = SensorData->SunValid;
+   Delta->InitCycle  = SensorData->InitCycle;
+   Delta->SensorMask = SensorData->SensorMask;
+
+   CFE_MSG_SetSize(CFE_MSG_PTR(Delta42->SensorDeltaMsg.TelemetryHeader),
+                   offsetof(BC42_INTF_SensorDeltaMsg_t, Payload.Data) + DataLen*sizeof(float));
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(Delta42->SensorDeltaMsg.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(Delta42->SensorDeltaMsg.TelemetryHeader), true);
+
+   for (; FieldMask != 0; FieldMask &= (FieldMask - 1))
+   {
+      ++FieldCnt;
+   }
+   ++Delta42->MsgCnt;
+   Delta42->FieldCnt += FieldCnt;
+
+   return FieldCnt;
+
+} /* End DELTA42_Send() */
+
+
+/******************************************************************************
+** Function: PackField
+**
+** Convert a vector to float32 and append it to the message data if it
+** changed since it was last sent or this is a key frame. Returns true if the
+** vector was appended.
+*/
+static bool PackField(DELTA42_Class_t *Delta42, uint16 PrevIndex, const double *Vec, uint16 Len,
+                      bool KeyFrame, uint16 *DataLen)
+{
+
+   float  Value[4];
+   float *Prev = &Delta42->Prev[PrevIndex];
+   uint16 i;
+
+   for (i=0; i < Len; i++)
+   {
+      Value[i] = (float)Vec[i];
+   }
+
+   if (!KeyFrame && (memcmp(Value, Prev, Len*sizeof(float)) == 0))
+   {
+      return false;
+   }
+
+   memcpy(Prev, Value, Len*sizeof(float));
+   memcpy(&Delta42->SensorDeltaMsg.Payload.Data[*DataLen], Value, Len*sizeof(float));
+   *DataLen += Len;
+
+   return true;
+
+} /* End PackField() */
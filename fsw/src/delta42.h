@@ -0,0 +1,124 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Publish a compact delta encoded copy of a link's sensor data message
+**
+**  Notes:
+**    1. The sensor delta message is intended for off-board analysis and
+**       recorders. The controller's input is always the full precision
+**       sensor data message which is published first.
+**    2. Vectors are converted to float32. A vector is only carried when one
+**       of its float32 components differs from the value in the previous
+**       delta message. Carried vectors are packed into Data in FieldMask bit
+**       order and the message length is trimmed to the packed data.
+**    3. Every KeyFrameCycles messages all vectors are carried and KeyFrame
+**       is set so a receiver that missed messages can resynchronize. The
+**       first message after construction or a reset is a key frame.
+**    4. All links publish on the same message ID and are distinguished by
+**       the payload's Link field.
+**    5. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _delta42_
+#define _delta42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** FieldMask bits, must agree with eds/bc42_intf.xml
+*/
+
+#define DELTA42_FIELD_POSN   0x01
+#define DELTA42_FIELD_VELN   0x02
+#define DELTA42_FIELD_QBN    0x04
+#define DELTA42_FIELD_WBN    0x08
+#define DELTA42_FIELD_SVB    0x10
+#define DELTA42_FIELD_BVB    0x20
+#define DELTA42_FIELD_WHLH   0x40
+#define DELTA42_FIELD_CNT    7
+
+#define DELTA42_DATA_LEN     23    /* Floats in all fields, must agree with the SensorDeltaData dimension */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** DELTA42 Class
+*/
+
+typedef struct
+{
+
+   bool    Enabled;
+   uint16  KeyFrameCycles;    /* Messages between key frames */
+   uint16  KeyFrameCnt;       /* Messages since the last key frame */
+   uint32  MsgCnt;
+   uint32  FieldCnt;          /* Vectors carried, MsgCnt*DELTA42_FIELD_CNT when nothing is suppressed */
+
+   float   Prev[DELTA42_DATA_LEN];   /* All fields in FieldMask bit order as last sent */
+
+   BC42_INTF_SensorDeltaMsg_t  SensorDeltaMsg;
+
+} DELTA42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: DELTA42_Constructor
+**
+** Notes:
+**   1. A zero KeyFrameCycles sends a key frame every message.
+**
+*/
+void DELTA42_Constructor(DELTA42_Class_t *Delta42, bool Enabled, CFE_SB_MsgId_t MsgId,
+                         uint8 Link, uint16 KeyFrameCycles);
+
+
+/******************************************************************************
+** Function: DELTA42_Reset
+**
+** Make the next message a key frame.
+**
+*/
+void DELTA42_Reset(DELTA42_Class_t *Delta42);
+
+
+/******************************************************************************
+** Function: DELTA42_Send
+**
+** Encode and publish a sensor data message payload. Returns the number of
+** vectors carried, zero if the object isn't enabled.
+**
+*/
+uint16 DELTA42_Send(DELTA42_Class_t *Delta42, const BC42_INTF_SensorDataMsg_Payload_t *SensorData);
+
+
+#endif /* _delta42_ */
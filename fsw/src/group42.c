@@ -0,0 +1,194 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Publish a link's sensor data split into per sensor group messages
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "group42.h"
+#include "wire42.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void LoadGroup(GROUP42_Class_t *Group42, uint16 GroupIndex,
+                      const BC42_INTF_SensorDataMsg_Payload_t *SensorData);
+
+
+/******************************************************************************
+** Function: GROUP42_Constructor
+**
+*/
+void GROUP42_Constructor(GROUP42_Class_t *Group42, uint8 Link,
+                         const CFE_SB_MsgId_t MsgId[GROUP42_CNT], const uint16 Decim[GROUP42_CNT])
+{
+
+   static const uint16 GroupSensorMask[GROUP42_CNT] =
+   {
+      WIRE42_SENSOR_GYRO, WIRE42_SENSOR_ST, WIRE42_SENSOR_GPS,
+      (WIRE42_SENSOR_SUN | WIRE42_SENSOR_MAG), WIRE42_SENSOR_WHL
+   };
+   static const size_t GroupMsgLen[GROUP42_CNT] =
+   {
+      sizeof(BC42_INTF_SensorImuMsg_t), sizeof(BC42_INTF_SensorAttitudeMsg_t), sizeof(BC42_INTF_SensorNavMsg_t),
+      sizeof(BC42_INTF_SensorSunMagMsg_t), sizeof(BC42_INTF_SensorWheelMsg_t)
+   };
+   uint16 i;
+
+   CFE_PSP_MemSet((void*)Group42, 0, sizeof(GROUP42_Class_t));
+
+   Group42->Group[GROUP42_IMU].TlmHdr      = &Group42->SensorImuMsg.TelemetryHeader;
+   Group42->Group[GROUP42_ATTITUDE].TlmHdr = &Group42->SensorAttitudeMsg.TelemetryHeader;
+   Group42->Group[GROUP42_NAV].TlmHdr      = &Group42->SensorNavMsg.TelemetryHeader;
+   Group42->Group[GROUP42_SUN_MAG].TlmHdr  = &Group42->SensorSunMagMsg.TelemetryHeader;
+   Group42->Group[GROUP42_WHEEL].TlmHdr    = &Group42->SensorWheelMsg.TelemetryHeader;
+
+   for (i=0; i < GROUP42_CNT; i++)
+   {
+      Group42->Group[i].Decim      = Decim[i];
+      Group42->Group[i].SensorMask = GroupSensorMask[i];
+      CFE_MSG_Init(CFE_MSG_PTR(*Group42->Group[i].TlmHdr), MsgId[i], GroupMsgLen[i]);
+   }
+
+   Group42->SensorImuMsg.Payload.Link      = Link;
+   Group42->SensorAttitudeMsg.Payload.Link = Link;
+   Group42->SensorNavMsg.Payload.Link      = Link;
+   Group42->SensorSunMagMsg.Payload.Link   = Link;
+   Group42->SensorWheelMsg.Payload.Link    = Link;
+
+   GROUP42_Reset(Group42);
+
+} /* End GROUP42_Constructor() */
+
+
+/******************************************************************************
+** Function: GROUP42_Reset
+**
+*/
+void GROUP42_Reset(GROUP42_Class_t *Group42)
+{
+
+   uint16 i;
+
+   for (i=0; i < GROUP42_CNT; i++)
+   {
+      Group42->Group[i].DecimCnt = Group42->Group[i].Decim;
+   }
+
+} /* End GROUP42_Reset() */
+
+
+/******************************************************************************
+** Function: GROUP42_Send
+**
+*/
+uint16 GROUP42_Send(GROUP42_Class_t *Group42, const BC42_INTF_SensorDataMsg_Payload_t *SensorData)
+{
+
+   GROUP42_Group_t *Group;
+   uint16 i;
+   uint16 SentCnt = 0;
+
+   for (i=0; i < GROUP42_CNT; i++)
+   {
+
+      Group = &Group42->Group[i];
+
+      if (Group->Decim == 0)
+      {
+         continue;
+      }
+      if (++Group->DecimCnt < Group->Decim)
+      {
+         continue;
+      }
+      Group->DecimCnt = 0;
+
+      if ((SensorData->SensorMask & Group->SensorMask) == 0)
+      {
+         continue;
+      }
+
+      LoadGroup(Group42, i, SensorData);
+      CFE_SB_TimeStampMsg(CFE_MSG_PTR(*Group->TlmHdr));
+      if (CFE_SB_TransmitMsg(CFE_MSG_PTR(*Group->TlmHdr), true) == CFE_SUCCESS)
+      {
+         ++Group->MsgCnt;
+         ++SentCnt;
+      }
+
+   } /* End group loop */
+
+   return SentCnt;
+
+} /* End GROUP42_Send() */
+
+
+/******************************************************************************
+** Function: LoadGroup
+**
+*/
+static void LoadGroup(GROUP42_Class_t *Group42, uint16 GroupIndex,
+                      const BC42_INTF_SensorDataMsg_Payload_t *SensorData)
+{
+
+   switch (GroupIndex)
+   {
+      case GROUP42_IMU:
+         Group42->SensorImuMsg.Payload.GpsTime = SensorData->GpsTime;
+         memcpy(Group42->SensorImuMsg.Payload.wbn, SensorData->wbn, sizeof(SensorData->wbn));
+         break;
+
+      case GROUP42_ATTITUDE:
+         Group42->SensorAttitudeMsg.Payload.GpsTime = SensorData->GpsTime;
+         Group42->SensorAttitudeMsg.Payload.StValid = SensorData->StValid;
+         memcpy(Group42->SensorAttitudeMsg.Payload.qbn, SensorData->qbn, sizeof(SensorData->qbn));
+         break;
+
+      case GROUP42_NAV:
+         Group42->SensorNavMsg.Payload.GpsTime  = SensorData->GpsTime;
+         Group42->SensorNavMsg.Payload.GpsValid = SensorData->GpsValid;
+         memcpy(Group42->SensorNavMsg.Payload.PosN, SensorData->PosN, sizeof(SensorData->PosN));
+         memcpy(Group42->SensorNavMsg.Payload.VelN, SensorData->VelN, sizeof(SensorData->VelN));
+         break;
+
+      case GROUP42_SUN_MAG:
+         Group42->SensorSunMagMsg.Payload.GpsTime  = SensorData->GpsTime;
+         Group42->SensorSunMagMsg.Payload.SunValid = SensorData->SunValid;
+         memcpy(Group42->SensorSunMagMsg.Payload.svb, SensorData->svb, sizeof(SensorData->svb));
+         memcpy(Group42->SensorSunMagMsg.Payload.bvb, SensorData->bvb, sizeof(SensorData->bvb));
+         break;
+
+      case GROUP42_WHEEL:
+         Group42->SensorWheelMsg.Payload.GpsTime = SensorData->GpsTime;
+         memcpy(Group42->SensorWheelMsg.Payload.WhlH, SensorData->WhlH, sizeof(SensorData->WhlH));
+         break;
+
+      default:
+         break;
+   }
+
+} /* End LoadGroup() */
@@ -0,0 +1,126 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Publish a link's sensor data split into per sensor group messages
+**
+**  Notes:
+**    1. Each group message carries one class of sensors so consumers that
+**       only need one class receive small messages at the rate they need.
+**       The full sensor data message is still published every cycle for
+**       the controller.
+**    2. A group message is published every Decim sensor data messages and a
+**       zero Decim disables it. The first sensor data message after
+**       construction or a reset publishes all enabled groups.
+**    3. A group isn't published while all of its sensors are disabled by
+**       the link's sensor mask.
+**    4. All links publish a group on the same message ID and are
+**       distinguished by the payload's Link field.
+**    5. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _group42_
+#define _group42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define GROUP42_IMU       0
+#define GROUP42_ATTITUDE  1
+#define GROUP42_NAV       2
+#define GROUP42_SUN_MAG   3
+#define GROUP42_WHEEL     4
+#define GROUP42_CNT       5
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   uint16  Decim;       /* Sensor data messages per group message, 0 disables the group */
+   uint16  DecimCnt;    /* Sensor data messages since the group was last published */
+   uint16  SensorMask;  /* WIRE42_SENSOR_x bits that feed the group */
+   uint32  MsgCnt;
+
+   CFE_MSG_TelemetryHeader_t *TlmHdr;
+
+} GROUP42_Group_t;
+
+
+/******************************************************************************
+** GROUP42 Class
+*/
+
+typedef struct
+{
+
+   GROUP42_Group_t  Group[GROUP42_CNT];
+
+   BC42_INTF_SensorImuMsg_t       SensorImuMsg;
+   BC42_INTF_SensorAttitudeMsg_t  SensorAttitudeMsg;
+   BC42_INTF_SensorNavMsg_t       SensorNavMsg;
+   BC42_INTF_SensorSunMagMsg_t    SensorSunMagMsg;
+   BC42_INTF_SensorWheelMsg_t     SensorWheelMsg;
+
+} GROUP42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: GROUP42_Constructor
+**
+** Notes:
+**   1. MsgId[] and Decim[] are indexed by GROUP42_x.
+**
+*/
+void GROUP42_Constructor(GROUP42_Class_t *Group42, uint8 Link,
+                         const CFE_SB_MsgId_t MsgId[GROUP42_CNT], const uint16 Decim[GROUP42_CNT]);
+
+
+/******************************************************************************
+** Function: GROUP42_Reset
+**
+** Publish all enabled groups with the next sensor data message.
+**
+*/
+void GROUP42_Reset(GROUP42_Class_t *Group42);
+
+
+/******************************************************************************
+** Function: GROUP42_Send
+**
+** Publish the groups that are due for a sensor data message payload. Returns
+** the number of group messages published.
+**
+*/
+uint16 GROUP42_Send(GROUP42_Class_t *Group42, const BC42_INTF_SensorDataMsg_Payload_t *SensorData);
+
+
+#endif /* _group42_ */
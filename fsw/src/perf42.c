@@ -0,0 +1,152 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the timing of the 42 interface control cycle
+**
+**  Notes:
+**    1. CFE_PSP_GetTime() is used because it is the PSP's high resolution
+**       monotonic time base.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "perf42.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddToHist(PERF42_Hist_t *Hist, uint32 Usec);
+
+
+/******************************************************************************
+** Function: PERF42_Constructor
+**
+*/
+void PERF42_Constructor(PERF42_Class_t *Perf42)
+{
+
+   CFE_PSP_MemSet((void*)Perf42, 0, sizeof(PERF42_Class_t));
+
+   PERF42_ResetStatus(Perf42);
+
+} /* End PERF42_Constructor() */
+
+
+/******************************************************************************
+** Function: PERF42_LoopMeanUsec
+**
+*/
+uint32 PERF42_LoopMeanUsec(const PERF42_Class_t *Perf42)
+{
+
+   uint32 MeanUsec = 0;
+
+   if (Perf42->LoopCnt > 0)
+   {
+      MeanUsec = (uint32)(Perf42->LoopSumUsec / Perf42->LoopCnt);
+   }
+
+   return MeanUsec;
+
+} /* End PERF42_LoopMeanUsec() */
+
+
+/******************************************************************************
+** Function: PERF42_Mark
+**
+*/
+void PERF42_Mark(PERF42_Class_t *Perf42, PERF42_Phase_t Phase)
+{
+
+   uint32 Usec;
+   uint32 ReadMark = 1 << PERF42_PHASE_READ;
+
+   CFE_PSP_GetTime(&Perf42->MarkTime[Phase]);
+
+   if (Phase == PERF42_PHASE_WAKEUP)
+   {
+      Perf42->CycleMarks = 0;
+   }
+   else if (Perf42->CycleMarks & (1 << (Phase-1)))
+   {
+      Usec = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Perf42->MarkTime[Phase], Perf42->MarkTime[Phase-1]));
+      AddToHist(&Perf42->Hist[Phase], Usec);
+   }
+
+   if ((Phase == PERF42_PHASE_WRITE) && (Perf42->CycleMarks & ReadMark))
+   {
+
+      Usec = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Perf42->MarkTime[Phase], Perf42->MarkTime[PERF42_PHASE_READ]));
+      AddToHist(&Perf42->Hist[PERF42_LOOP_INTERVAL], Usec);
+
+      ++Perf42->LoopCnt;
+      Perf42->LoopSumUsec += Usec;
+      if (Usec < Perf42->LoopMinUsec)
+      {
+         Perf42->LoopMinUsec = Usec;
+      }
+      if (Usec > Perf42->LoopMaxUsec)
+      {
+         Perf42->LoopMaxUsec = Usec;
+      }
+
+   }
+
+   Perf42->CycleMarks |= (1 << Phase);
+
+} /* End PERF42_Mark() */
+
+
+/******************************************************************************
+** Function: PERF42_ResetStatus
+**
+*/
+void PERF42_ResetStatus(PERF42_Class_t *Perf42)
+{
+
+   CFE_PSP_MemSet((void*)Perf42->Hist, 0, sizeof(Perf42->Hist));
+
+   Perf42->LoopCnt     = 0;
+   Perf42->LoopMinUsec = 0xFFFFFFFF;
+   Perf42->LoopMaxUsec = 0;
+   Perf42->LoopSumUsec = 0;
+
+} /* End PERF42_ResetStatus() */
+
+
+/******************************************************************************
+** Function: AddToHist
+**
+*/
+static void AddToHist(PERF42_Hist_t *Hist, uint32 Usec)
+{
+
+   uint16 i = 0;
+
+   Usec >>= PERF42_HIST_BUCKET0_LOG2;
+   while ((Usec > 0) && (i < (PERF42_HIST_BUCKETS-1)))
+   {
+      Usec >>= 1;
+      ++i;
+   }
+
+   ++Hist->Bucket[i];
+
+} /* End AddToHist() */
@@ -0,0 +1,144 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Measure the timing of the 42 interface control cycle
+**
+**  Notes:
+**    1. COMM42 marks each phase of a sensor-controller-actuator cycle and
+**       this object accumulates fixed-bucket histograms of the time between
+**       consecutive phases and of the closed-loop latency. The closed-loop
+**       latency is measured from the sensor socket read completing to the
+**       actuator socket write completing.
+**    2. Bucket n counts durations less than 2^(n+4) microseconds that were
+**       not counted by a lower bucket. The last bucket is unbounded.
+**    3. Every mark, from wakeup through the actuator received and write
+**       marks, is made by COMM42's child task and the status is only reset
+**       by the child so no lock is used. The parent only reads the status
+**       for telemetry.
+**    4. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _perf42_
+#define _perf42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PERF42_HIST_BUCKETS      16  /* Must agree with EDS LatencyHist dimension */
+#define PERF42_HIST_BUCKET0_LOG2  4   /* Bucket 0 upper bound is 2^4 usec */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   PERF42_PHASE_WAKEUP        = 0,   /* Child task semaphore taken       */
+   PERF42_PHASE_READ          = 1,   /* Sensor socket read complete      */
+   PERF42_PHASE_PROCESS       = 2,   /* Sensor processing complete       */
+   PERF42_PHASE_TRANSMIT      = 3,   /* Sensor data message sent         */
+   PERF42_PHASE_ACTUATOR_RECV = 4,   /* Actuator command message received */
+   PERF42_PHASE_WRITE         = 5,   /* Actuator socket write complete   */
+   PERF42_PHASE_CNT           = 6
+
+} PERF42_Phase_t;
+
+
+/*
+** Intervals are identified by the phase that ends them so interval n is the
+** time from phase n-1 to phase n. Interval 0 is used for the closed-loop
+** latency.
+*/
+#define PERF42_LOOP_INTERVAL  0
+
+
+typedef struct
+{
+
+   uint32  Bucket[PERF42_HIST_BUCKETS];
+
+} PERF42_Hist_t;
+
+
+/******************************************************************************
+** PERF42 Class
+*/
+
+typedef struct
+{
+
+   uint32     CycleMarks;                 /* Bit per phase marked in the current cycle */
+   OS_time_t  MarkTime[PERF42_PHASE_CNT];
+
+   PERF42_Hist_t  Hist[PERF42_PHASE_CNT]; /* Indexed by interval */
+
+   uint32  LoopCnt;
+   uint32  LoopMinUsec;
+   uint32  LoopMaxUsec;
+   uint64  LoopSumUsec;
+
+} PERF42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: PERF42_Constructor
+**
+*/
+void PERF42_Constructor(PERF42_Class_t *Perf42);
+
+
+/******************************************************************************
+** Function: PERF42_LoopMeanUsec
+**
+*/
+uint32 PERF42_LoopMeanUsec(const PERF42_Class_t *Perf42);
+
+
+/******************************************************************************
+** Function: PERF42_Mark
+**
+** Timestamp a cycle phase and update the interval histograms.
+**
+** Notes:
+**   1. PERF42_PHASE_WAKEUP starts a new cycle. An interval is only recorded
+**      when its starting phase was marked in the same cycle.
+**
+*/
+void PERF42_Mark(PERF42_Class_t *Perf42, PERF42_Phase_t Phase);
+
+
+/******************************************************************************
+** Function: PERF42_ResetStatus
+**
+*/
+void PERF42_ResetStatus(PERF42_Class_t *Perf42);
+
+
+#endif /* _perf42_ */
@@ -0,0 +1,327 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Record and replay the 42 sensor and actuator frame stream
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "rec42.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void WriteRec(REC42_Class_t *Rec42, uint16 Type, uint16 Link, uint32 Cycle,
+                     double SimTime, const void *Frame, uint32 FrameLen);
+
+
+/******************************************************************************
+** Function: REC42_Constructor
+**
+*/
+void REC42_Constructor(REC42_Class_t *Rec42)
+{
+
+   CFE_PSP_MemSet((void*)Rec42, 0, sizeof(REC42_Class_t));
+
+} /* End REC42_Constructor() */
+
+
+/******************************************************************************
+** Function: REC42_Close
+**
+*/
+void REC42_Close(REC42_Class_t *Rec42)
+{
+
+   if (Rec42->FileOpen)
+   {
+      
+      Rec42->FileOpen = false;
+      OS_close(Rec42->FileHandle);
+      
+      CFE_EVS_SendEvent(REC42_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
+                        "Closed %s after %s %d records with %d errors", Rec42->Filename,
+                        Rec42->Replay ? "reading" : "writing", Rec42->RecCnt, Rec42->ErrCnt);
+   }
+
+} /* End REC42_Close() */
+
+
+/******************************************************************************
+** Function: REC42_OpenRecord
+**
+*/
+bool REC42_OpenRecord(REC42_Class_t *Rec42, const char *Filename)
+{
+
+   int32  SysStatus;
+   int32  WriteLen = 0;
+   CFE_FS_Header_t  CfeHdr;
+   REC42_FileHdr_t  FileHdr;
+
+   REC42_Close(Rec42);
+   
+   Rec42->Replay = false;
+   Rec42->RecCnt = 0;
+   Rec42->ErrCnt = 0;
+   strncpy(Rec42->Filename, Filename, OS_MAX_PATH_LEN);
+   Rec42->Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SysStatus = OS_OpenCreate(&Rec42->FileHandle, Rec42->Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      FileHdr.Version     = REC42_FILE_VERSION;
+      FileHdr.SensorLen   = sizeof(WIRE42_SensorFrame_t);
+      FileHdr.ActuatorLen = sizeof(WIRE42_ActuatorFrame_t);
+
+      CFE_FS_InitHeader(&CfeHdr, "BC42 Interface Recording", REC42_FILE_SUBTYPE);
+      if (CFE_FS_WriteHeader(Rec42->FileHandle, &CfeHdr) == sizeof(CFE_FS_Header_t))
+      {
+         WriteLen = OS_write(Rec42->FileHandle, &FileHdr, sizeof(REC42_FileHdr_t));
+      }
+      
+      if (WriteLen == sizeof(REC42_FileHdr_t))
+      {
+         Rec42->FileOpen = true;
+         CFE_EVS_SendEvent(REC42_OPEN_EID, CFE_EVS_EventType_INFORMATION,
+                           "Recording the 42 sensor and actuator stream to %s", Rec42->Filename);
+      }
+      else
+      {
+         OS_close(Rec42->FileHandle);
+         CFE_EVS_SendEvent(REC42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing recording file %s header. Status=%d", Rec42->Filename, WriteLen);
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(REC42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating recording file %s. Status=%d", Rec42->Filename, SysStatus);
+   }
+
+   return Rec42->FileOpen;
+
+} /* End REC42_OpenRecord() */
+
+
+/******************************************************************************
+** Function: REC42_OpenReplay
+**
+** Notes:
+**   1. The file header's frame lengths must match this build's frames so a
+**      recording can't be replayed on a processor with a different layout.
+**
+*/
+bool REC42_OpenReplay(REC42_Class_t *Rec42, const char *Filename)
+{
+
+   int32  SysStatus;
+   int32  ReadLen = 0;
+   CFE_FS_Header_t  CfeHdr;
+   REC42_FileHdr_t  FileHdr;
+
+   REC42_Close(Rec42);
+   
+   Rec42->Replay = true;
+   Rec42->RecCnt = 0;
+   Rec42->ErrCnt = 0;
+   strncpy(Rec42->Filename, Filename, OS_MAX_PATH_LEN);
+   Rec42->Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SysStatus = OS_OpenCreate(&Rec42->FileHandle, Rec42->Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      if (CFE_FS_ReadHeader(&CfeHdr, Rec42->FileHandle) == sizeof(CFE_FS_Header_t))
+      {
+         ReadLen = OS_read(Rec42->FileHandle, &FileHdr, sizeof(REC42_FileHdr_t));
+      }
+      
+      if ((ReadLen == sizeof(REC42_FileHdr_t)) &&
+          (CfeHdr.SubType      == REC42_FILE_SUBTYPE) &&
+          (FileHdr.Version     == REC42_FILE_VERSION) &&
+          (FileHdr.SensorLen   == sizeof(WIRE42_SensorFrame_t)) &&
+          (FileHdr.ActuatorLen == sizeof(WIRE42_ActuatorFrame_t)))
+      {
+         Rec42->FileOpen = true;
+         CFE_EVS_SendEvent(REC42_OPEN_EID, CFE_EVS_EventType_INFORMATION,
+                           "Replaying the 42 sensor stream from %s", Rec42->Filename);
+      }
+      else
+      {
+         OS_close(Rec42->FileHandle);
+         CFE_EVS_SendEvent(REC42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                           "Replay file %s isn't a compatible recording. Header read status=%d", 
+                           Rec42->Filename, ReadLen);
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(REC42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                        "Error opening replay file %s. Status=%d", Rec42->Filename, SysStatus);
+   }
+
+   return Rec42->FileOpen;
+
+} /* End REC42_OpenReplay() */
+
+
+/******************************************************************************
+** Function: REC42_ReadSensorFrame
+**
+*/
+int32 REC42_ReadSensorFrame(REC42_Class_t *Rec42, uint16 Link, 
+                            WIRE42_SensorFrame_t *SensorFrame)
+{
+
+   int32  ReadLen;
+   int32  FrameLen = 0;
+   REC42_RecHdr_t  RecHdr;
+
+   while (Rec42->FileOpen && Rec42->Replay && (FrameLen == 0))
+   {
+      
+      ReadLen = OS_read(Rec42->FileHandle, &RecHdr, sizeof(REC42_RecHdr_t));
+      if (ReadLen != sizeof(REC42_RecHdr_t))
+      {
+         /* A partial record header is a truncated recording's end */
+         break;
+      }
+   
+      if ((RecHdr.Type == REC42_TYPE_SENSOR) && (RecHdr.Link == Link))
+      {
+         
+         ReadLen = OS_read(Rec42->FileHandle, SensorFrame, sizeof(WIRE42_SensorFrame_t));
+         if (ReadLen == sizeof(WIRE42_SensorFrame_t))
+         {
+            ++Rec42->RecCnt;
+            FrameLen = ReadLen;
+         }
+         else
+         {
+            break;
+         }
+      }
+      else
+      {
+         
+         ReadLen = (RecHdr.Type == REC42_TYPE_SENSOR) ? sizeof(WIRE42_SensorFrame_t) : sizeof(WIRE42_ActuatorFrame_t);
+         if (OS_lseek(Rec42->FileHandle, ReadLen, OS_SEEK_CUR) < 0)
+         {
+            ++Rec42->ErrCnt;
+            FrameLen = OS_ERROR;
+            CFE_EVS_SendEvent(REC42_READ_EID, CFE_EVS_EventType_ERROR,
+                              "Error skipping a record in replay file %s", Rec42->Filename);
+         }
+      }
+      
+   } /* End while searching */
+
+   return FrameLen;
+
+} /* End REC42_ReadSensorFrame() */
+
+
+/******************************************************************************
+** Function: REC42_WriteActuatorFrame
+**
+*/
+void REC42_WriteActuatorFrame(REC42_Class_t *Rec42, uint16 Link, uint32 Cycle,
+                              double SimTime, const WIRE42_ActuatorFrame_t *ActuatorFrame)
+{
+
+   WriteRec(Rec42, REC42_TYPE_ACTUATOR, Link, Cycle, SimTime, ActuatorFrame, sizeof(WIRE42_ActuatorFrame_t));
+
+} /* End REC42_WriteActuatorFrame() */
+
+
+/******************************************************************************
+** Function: REC42_WriteSensorFrame
+**
+*/
+void REC42_WriteSensorFrame(REC42_Class_t *Rec42, uint16 Link, uint32 Cycle,
+                            const WIRE42_SensorFrame_t *SensorFrame)
+{
+
+   WriteRec(Rec42, REC42_TYPE_SENSOR, Link, Cycle, SensorFrame->Time, SensorFrame, sizeof(WIRE42_SensorFrame_t));
+
+} /* End REC42_WriteSensorFrame() */
+
+
+/******************************************************************************
+** Function: WriteRec
+**
+** Notes:
+**   1. The record header and frame are assembled so the record is written
+**      with one OS_write().
+**
+*/
+static void WriteRec(REC42_Class_t *Rec42, uint16 Type, uint16 Link, uint32 Cycle,
+                     double SimTime, const void *Frame, uint32 FrameLen)
+{
+
+   int32      WriteLen;
+   OS_time_t  Time;
+   struct
+   {
+      REC42_RecHdr_t  Hdr;
+      uint8           Frame[sizeof(WIRE42_SensorFrame_t)];   /* Largest frame */
+   } Rec;
+   
+   if (Rec42->FileOpen && !Rec42->Replay)
+   {
+      
+      CFE_PSP_GetTime(&Time);
+      
+      Rec.Hdr.WallTimeUsec = OS_TimeGetTotalMicroseconds(Time);
+      Rec.Hdr.SimTime      = SimTime;
+      Rec.Hdr.Cycle        = Cycle;
+      Rec.Hdr.Type         = Type;
+      Rec.Hdr.Link         = Link;
+      memcpy(Rec.Frame, Frame, FrameLen);
+      
+      WriteLen = OS_write(Rec42->FileHandle, &Rec, sizeof(REC42_RecHdr_t) + FrameLen);
+      
+      if (WriteLen == (int32)(sizeof(REC42_RecHdr_t) + FrameLen))
+      {
+         ++Rec42->RecCnt;
+      }
+      else
+      {
+         if (Rec42->ErrCnt++ == 0)
+         {
+            CFE_EVS_SendEvent(REC42_WRITE_EID, CFE_EVS_EventType_ERROR,
+                              "Error writing recording file %s. Status=%d", Rec42->Filename, WriteLen);
+         }
+      }
+   }
+
+} /* End WriteRec() */
@@ -0,0 +1,181 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Record and replay the 42 sensor and actuator frame stream
+**
+**  Notes:
+**    1. A recording is a cFE file header, a REC42_FileHdr_t, and a sequence
+**       of records. Each record is a REC42_RecHdr_t followed by a
+**       WIRE42_SensorFrame_t or a WIRE42_ActuatorFrame_t, all in the
+**       processor's native byte order.
+**    2. Each record is written with a single OS_write(). COMM42's child task
+**       makes both the sensor and actuator records and opens and closes the
+**       file, so records are in the order they were made and the file is
+**       never closed under a write.
+**    3. A replay reads the sensor records of one link and skips all other
+**       records so each link being replayed uses its own instance.
+**    4. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _rec42_
+#define _rec42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "wire42.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define REC42_FILE_VERSION   1
+#define REC42_FILE_SUBTYPE   (CFE_FS_SubType_USER_BASE + 0x43)
+
+#define REC42_TYPE_SENSOR    1
+#define REC42_TYPE_ACTUATOR  2
+
+/*
+** Event Message IDs
+*/
+
+#define REC42_OPEN_EID   (REC42_BASE_EID + 0)
+#define REC42_CLOSE_EID  (REC42_BASE_EID + 1)
+#define REC42_WRITE_EID  (REC42_BASE_EID + 2)
+#define REC42_READ_EID   (REC42_BASE_EID + 3)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   int64   WallTimeUsec;   /* CFE_PSP_GetTime() in microseconds */
+   double  SimTime;        /* 42 time of the sensor frame or the sensor frame being answered */
+   uint32  Cycle;
+   uint16  Type;           /* REC42_TYPE_x */
+   uint16  Link;
+
+} REC42_RecHdr_t;
+
+
+typedef struct
+{
+
+   uint32  Version;
+   uint32  SensorLen;      /* sizeof(WIRE42_SensorFrame_t) */
+   uint32  ActuatorLen;    /* sizeof(WIRE42_ActuatorFrame_t) */
+
+} REC42_FileHdr_t;
+
+
+/******************************************************************************
+** REC42 Class
+*/
+
+typedef struct
+{
+
+   bool       FileOpen;
+   bool       Replay;       /* File is open for reading */
+   osal_id_t  FileHandle;
+   uint32     RecCnt;       /* Records written or read */
+   uint32     ErrCnt;
+   
+   char  Filename[OS_MAX_PATH_LEN];
+
+} REC42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: REC42_Constructor
+**
+*/
+void REC42_Constructor(REC42_Class_t *Rec42);
+
+
+/******************************************************************************
+** Function: REC42_Close
+**
+*/
+void REC42_Close(REC42_Class_t *Rec42);
+
+
+/******************************************************************************
+** Function: REC42_OpenRecord
+**
+** Create a recording file. An open file is closed first.
+**
+*/
+bool REC42_OpenRecord(REC42_Class_t *Rec42, const char *Filename);
+
+
+/******************************************************************************
+** Function: REC42_OpenReplay
+**
+** Open a recording file for replay. An open file is closed first.
+**
+*/
+bool REC42_OpenReplay(REC42_Class_t *Rec42, const char *Filename);
+
+
+/******************************************************************************
+** Function: REC42_ReadSensorFrame
+**
+** Read the next sensor frame recorded for Link.
+**
+** Notes:
+**   1. Returns the frame length, zero at the end of the recording, or a
+**      negative value if a read error occurred.
+**
+*/
+int32 REC42_ReadSensorFrame(REC42_Class_t *Rec42, uint16 Link, 
+                            WIRE42_SensorFrame_t *SensorFrame);
+
+
+/******************************************************************************
+** Function: REC42_WriteActuatorFrame
+**
+** Notes:
+**   1. Nothing is written if a recording isn't open.
+**
+*/
+void REC42_WriteActuatorFrame(REC42_Class_t *Rec42, uint16 Link, uint32 Cycle,
+                              double SimTime, const WIRE42_ActuatorFrame_t *ActuatorFrame);
+
+
+/******************************************************************************
+** Function: REC42_WriteSensorFrame
+**
+** Notes:
+**   1. Nothing is written if a recording isn't open.
+**
+*/
+void REC42_WriteSensorFrame(REC42_Class_t *Rec42, uint16 Link, uint32 Cycle,
+                            const WIRE42_SensorFrame_t *SensorFrame);
+
+
+#endif /* _rec42_ */
@@ -0,0 +1,502 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Provide a shared memory byte stream transport to a co-located 42
+**
+**  Notes:
+**    1. OSAL doesn't abstract shared memory or futexes so the segment is
+**       managed with POSIX and Linux calls. On other platforms SHM42_Open()
+**       fails and the socket transport must be used.
+**    2. The GCC/Clang __atomic builtins are used for the ring indices and
+**       doorbell. Indices are published with release ordering and read with
+**       acquire ordering so a byte is visible before its index. Waiting and
+**       Doorbell use sequentially consistent ordering so either the producer
+**       sees Waiting set or the consumer sees the new Head before it pends.
+**    3. The client's session is odd while it has the segment open. A server
+**       treats an even, non-zero session as a closed peer.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#endif
+
+#include "shm42.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool  MapSegment(SHM42_Class_t *Shm42, const char *Name, bool Create);
+static bool  PeerClosed(const SHM42_Class_t *Shm42);
+static bool  RingDoorbell(SHM42_Ring_t *Ring);
+static bool  WaitDoorbell(SHM42_Ring_t *Ring, uint32 Doorbell, int32 Timeout);
+
+
+/******************************************************************************
+** Function: SHM42_Constructor
+**
+*/
+void SHM42_Constructor(SHM42_Class_t *Shm42)
+{
+
+   CFE_PSP_MemSet((void*)Shm42, 0, sizeof(SHM42_Class_t));
+
+   Shm42->Fd = -1;
+
+} /* End SHM42_Constructor() */
+
+
+/******************************************************************************
+** Function: SHM42_Close
+**
+*/
+void SHM42_Close(SHM42_Class_t *Shm42)
+{
+
+   if (!Shm42->Open)
+   {
+      return;
+   }
+
+   if (Shm42->Server)
+   {
+      __atomic_store_n(&Shm42->Segment->ServerClosed, 1, __ATOMIC_SEQ_CST);
+   }
+   else
+   {
+      __atomic_add_fetch(&Shm42->Segment->ClientSession, 1, __ATOMIC_SEQ_CST);
+   }
+   RingDoorbell(Shm42->TxRing);
+
+#ifdef __linux__
+   munmap(Shm42->Segment, sizeof(SHM42_Segment_t));
+   close(Shm42->Fd);
+   if (Shm42->Server)
+   {
+      shm_unlink(Shm42->Name);
+   }
+#endif
+
+   CFE_EVS_SendEvent(SHM42_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
+                     "Closed shared memory segment %s", Shm42->Name);
+
+   Shm42->Open    = false;
+   Shm42->Fd      = -1;
+   Shm42->Segment = NULL;
+   Shm42->RxRing  = NULL;
+   Shm42->TxRing  = NULL;
+
+} /* End SHM42_Close() */
+
+
+/******************************************************************************
+** Function: SHM42_Create
+**
+*/
+bool SHM42_Create(SHM42_Class_t *Shm42, const char *Name)
+{
+
+   SHM42_Segment_t *Segment;
+
+   if (!MapSegment(Shm42, Name, true))
+   {
+      return false;
+   }
+
+   Segment = Shm42->Segment;
+   memset(Segment, 0, sizeof(SHM42_Segment_t));
+   Segment->Version = SHM42_VERSION;
+   Segment->RingLen = SHM42_RING_LEN;
+   __atomic_store_n(&Segment->Magic, SHM42_MAGIC, __ATOMIC_RELEASE);
+
+   Shm42->Server = true;
+   Shm42->RxRing = &Segment->ActuatorRing;
+   Shm42->TxRing = &Segment->SensorRing;
+   Shm42->Open   = true;
+
+   return true;
+
+} /* End SHM42_Create() */
+
+
+/******************************************************************************
+** Function: SHM42_Open
+**
+*/
+bool SHM42_Open(SHM42_Class_t *Shm42, const char *Name)
+{
+
+   SHM42_Segment_t *Segment;
+   SHM42_Ring_t    *SensorRing;
+
+   if (!MapSegment(Shm42, Name, false))
+   {
+      return false;
+   }
+
+   Segment = Shm42->Segment;
+   if ((__atomic_load_n(&Segment->Magic, __ATOMIC_ACQUIRE) != SHM42_MAGIC) ||
+       (Segment->Version != SHM42_VERSION) || (Segment->RingLen != SHM42_RING_LEN))
+   {
+      CFE_EVS_SendEvent(SHM42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                        "Shared memory segment %s not initialized or incompatible. Magic=0x%08X, Version=%d, RingLen=%d",
+                        Name, (unsigned int)Segment->Magic, (int)Segment->Version, (int)Segment->RingLen);
+#ifdef __linux__
+      munmap(Segment, sizeof(SHM42_Segment_t));
+      close(Shm42->Fd);
+#endif
+      Shm42->Fd      = -1;
+      Shm42->Segment = NULL;
+      return false;
+   }
+
+   SensorRing = &Segment->SensorRing;
+   __atomic_store_n(&SensorRing->Tail, __atomic_load_n(&SensorRing->Head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+   __atomic_add_fetch(&Segment->ClientSession, 1, __ATOMIC_SEQ_CST);
+
+   Shm42->Server = false;
+   Shm42->RxRing = SensorRing;
+   Shm42->TxRing = &Segment->ActuatorRing;
+   Shm42->Open   = true;
+   RingDoorbell(Shm42->TxRing);
+
+   CFE_EVS_SendEvent(SHM42_OPEN_EID, CFE_EVS_EventType_INFORMATION,
+                     "Opened shared memory segment %s, session %d",
+                     Name, (int)Segment->ClientSession);
+
+   return true;
+
+} /* End SHM42_Open() */
+
+
+/******************************************************************************
+** Function: SHM42_Read
+**
+*/
+int32 SHM42_Read(SHM42_Class_t *Shm42, void *Buf, uint32 Len, int32 Timeout)
+{
+
+   SHM42_Ring_t *Ring = Shm42->RxRing;
+   uint32 Head, Tail, Used, Start, FirstLen;
+
+   if (!SHM42_Wait(Shm42, Timeout))
+   {
+      return OS_ERROR_TIMEOUT;
+   }
+
+   Tail = Ring->Tail;
+   Head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+   if (Head == Tail)
+   {
+      return 0;   /* Peer closed */
+   }
+
+   Used = Head - Tail;
+   if (Len > Used)
+   {
+      Len = Used;
+   }
+
+   Start    = Tail & (SHM42_RING_LEN - 1);
+   FirstLen = SHM42_RING_LEN - Start;
+   if (FirstLen >= Len)
+   {
+      memcpy(Buf, &Ring->Data[Start], Len);
+   }
+   else
+   {
+      memcpy(Buf, &Ring->Data[Start], FirstLen);
+      memcpy((uint8 *)Buf + FirstLen, Ring->Data, Len - FirstLen);
+   }
+   __atomic_store_n(&Ring->Tail, Tail + Len, __ATOMIC_RELEASE);
+
+   ++Shm42->ReadCnt;
+
+   return (int32)Len;
+
+} /* End SHM42_Read() */
+
+
+/******************************************************************************
+** Function: SHM42_Readable
+**
+*/
+bool SHM42_Readable(const SHM42_Class_t *Shm42)
+{
+
+   return ((__atomic_load_n(&Shm42->RxRing->Head, __ATOMIC_ACQUIRE) != Shm42->RxRing->Tail) ||
+           PeerClosed(Shm42));
+
+} /* End SHM42_Readable() */
+
+
+/******************************************************************************
+** Function: SHM42_Wait
+**
+** Notes:
+**   1. The doorbell is sampled before the ring is checked so a write that
+**      lands between the check and the wait changes the doorbell and the
+**      wait returns immediately.
+**
+*/
+bool SHM42_Wait(SHM42_Class_t *Shm42, int32 Timeout)
+{
+
+   SHM42_Ring_t *Ring = Shm42->RxRing;
+   uint32 Doorbell;
+   bool   Readable;
+
+   while (true)
+   {
+
+      Doorbell = __atomic_load_n(&Ring->Doorbell, __ATOMIC_SEQ_CST);
+      if (SHM42_Readable(Shm42))
+      {
+         return true;
+      }
+      if (Timeout == 0)
+      {
+         return false;
+      }
+
+      ++Shm42->WaitCnt;
+      __atomic_store_n(&Ring->Waiting, 1, __ATOMIC_SEQ_CST);
+      Readable = SHM42_Readable(Shm42) || WaitDoorbell(Ring, Doorbell, Timeout);
+      __atomic_store_n(&Ring->Waiting, 0, __ATOMIC_SEQ_CST);
+      if (!Readable)
+      {
+         return false;
+      }
+
+   } /* End while */
+
+} /* End SHM42_Wait() */
+
+
+/******************************************************************************
+** Function: SHM42_Write
+**
+*/
+int32 SHM42_Write(SHM42_Class_t *Shm42, const void *Buf, uint32 Len)
+{
+
+   SHM42_Ring_t *Ring = Shm42->TxRing;
+   uint32 Head = Ring->Head;
+   uint32 Tail = __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE);
+   uint32 Start, FirstLen;
+
+   if (Len > (SHM42_RING_LEN - (Head - Tail)))
+   {
+      return OS_QUEUE_FULL;
+   }
+
+   Start    = Head & (SHM42_RING_LEN - 1);
+   FirstLen = SHM42_RING_LEN - Start;
+   if (FirstLen >= Len)
+   {
+      memcpy(&Ring->Data[Start], Buf, Len);
+   }
+   else
+   {
+      memcpy(&Ring->Data[Start], Buf, FirstLen);
+      memcpy(Ring->Data, (const uint8 *)Buf + FirstLen, Len - FirstLen);
+   }
+   __atomic_store_n(&Ring->Head, Head + Len, __ATOMIC_RELEASE);
+
+   if (RingDoorbell(Ring))
+   {
+      ++Shm42->WakeCnt;
+   }
+
+   return (int32)Len;
+
+} /* End SHM42_Write() */
+
+
+/******************************************************************************
+** Function: MapSegment
+**
+** Open or create a named segment and map it into Shm42->Segment.
+*/
+static bool MapSegment(SHM42_Class_t *Shm42, const char *Name, bool Create)
+{
+
+#ifdef __linux__
+
+   void *Addr;
+
+   strncpy(Shm42->Name, Name, SHM42_NAME_LEN);
+   Shm42->Name[SHM42_NAME_LEN-1] = '\0';
+
+   Shm42->Fd = shm_open(Shm42->Name, Create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0660);
+   if (Shm42->Fd < 0)
+   {
+      CFE_EVS_SendEvent(SHM42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                        "Error opening shared memory segment %s, errno=%d", Shm42->Name, errno);
+      return false;
+   }
+
+   if (Create && (ftruncate(Shm42->Fd, sizeof(SHM42_Segment_t)) != 0))
+   {
+      CFE_EVS_SendEvent(SHM42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                        "Error sizing shared memory segment %s, errno=%d", Shm42->Name, errno);
+      close(Shm42->Fd);
+      shm_unlink(Shm42->Name);
+      Shm42->Fd = -1;
+      return false;
+   }
+
+   Addr = mmap(NULL, sizeof(SHM42_Segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, Shm42->Fd, 0);
+   if (Addr == MAP_FAILED)
+   {
+      CFE_EVS_SendEvent(SHM42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                        "Error mapping shared memory segment %s, errno=%d", Shm42->Name, errno);
+      close(Shm42->Fd);
+      Shm42->Fd = -1;
+      return false;
+   }
+
+   Shm42->Segment = (SHM42_Segment_t *)Addr;
+
+   return true;
+
+#else
+
+   CFE_EVS_SendEvent(SHM42_OPEN_EID, CFE_EVS_EventType_ERROR,
+                     "Shared memory segment %s can't be opened, the transport requires Linux", Name);
+   return false;
+
+#endif
+
+} /* End MapSegment() */
+
+
+/******************************************************************************
+** Function: PeerClosed
+**
+*/
+static bool PeerClosed(const SHM42_Class_t *Shm42)
+{
+
+   uint32 Session;
+
+   if (Shm42->Server)
+   {
+      Session = __atomic_load_n(&Shm42->Segment->ClientSession, __ATOMIC_ACQUIRE);
+      return ((Session != 0) && ((Session & 1) == 0));
+   }
+
+   return (__atomic_load_n(&Shm42->Segment->ServerClosed, __ATOMIC_ACQUIRE) != 0);
+
+} /* End PeerClosed() */
+
+
+/******************************************************************************
+** Function: RingDoorbell
+**
+** Advance the doorbell and wake the consumer if it's pending. Returns true
+** if the consumer was woken.
+*/
+static bool RingDoorbell(SHM42_Ring_t *Ring)
+{
+
+   __atomic_add_fetch(&Ring->Doorbell, 1, __ATOMIC_SEQ_CST);
+
+   if (!__atomic_load_n(&Ring->Waiting, __ATOMIC_SEQ_CST))
+   {
+      return false;
+   }
+
+#ifdef __linux__
+   syscall(SYS_futex, &Ring->Doorbell, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+
+   return true;
+
+} /* End RingDoorbell() */
+
+
+/******************************************************************************
+** Function: WaitDoorbell
+**
+** Pend until the doorbell differs from Doorbell or Timeout milliseconds
+** elapse. Returns false on a timeout.
+*/
+static bool WaitDoorbell(SHM42_Ring_t *Ring, uint32 Doorbell, int32 Timeout)
+{
+
+#ifdef __linux__
+
+   struct timespec Now, Deadline, Remain;
+   int64 RemainNsec;
+
+   if (Timeout != OS_PEND)
+   {
+      clock_gettime(CLOCK_MONOTONIC, &Deadline);
+      Deadline.tv_sec  += Timeout / 1000;
+      Deadline.tv_nsec += (long)(Timeout % 1000) * 1000000L;
+      if (Deadline.tv_nsec >= 1000000000L)
+      {
+         ++Deadline.tv_sec;
+         Deadline.tv_nsec -= 1000000000L;
+      }
+   }
+
+   /* Spurious and signal wakeups repeat the wait with the remaining time */
+   while (__atomic_load_n(&Ring->Doorbell, __ATOMIC_SEQ_CST) == Doorbell)
+   {
+
+      if (Timeout == OS_PEND)
+      {
+         syscall(SYS_futex, &Ring->Doorbell, FUTEX_WAIT, Doorbell, NULL, NULL, 0);
+         continue;
+      }
+
+      clock_gettime(CLOCK_MONOTONIC, &Now);
+      RemainNsec = (int64)(Deadline.tv_sec - Now.tv_sec)*1000000000LL + (Deadline.tv_nsec - Now.tv_nsec);
+      if (RemainNsec <= 0)
+      {
+         return false;
+      }
+      Remain.tv_sec  = RemainNsec / 1000000000LL;
+      Remain.tv_nsec = RemainNsec % 1000000000LL;
+      syscall(SYS_futex, &Ring->Doorbell, FUTEX_WAIT, Doorbell, &Remain, NULL, 0);
+
+   }
+
+   return true;
+
+#else
+
+   return false;
+
+#endif
+
+} /* End WaitDoorbell() */
@@ -0,0 +1,215 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Provide a shared memory byte stream transport to a co-located 42
+**
+**  Notes:
+**    1. A link's WIRE42 frames are carried through a POSIX shared memory
+**       segment instead of a TCP loopback socket when 42 runs on the same
+**       host. Sending a frame is a copy into a ring plus a wakeup.
+**    2. 42 is the server. It creates and initializes the segment and sets
+**       Magic last so a client never maps a partially initialized segment.
+**       The interface is the client and opens an existing segment.
+**    3. The segment holds two single-producer single-consumer byte rings.
+**       The sensor ring is written by 42 and the actuator ring is written by
+**       the interface. Head is only written by the producer and Tail is only
+**       written by the consumer, both are free running byte counts.
+**    4. Each ring has a doorbell word that the producer increments after
+**       every write. A consumer with nothing to read sets Waiting and pends
+**       on the doorbell with a Linux futex, so the producer only makes the
+**       wake system call when the consumer is waiting.
+**    5. The segment layout is shared with 42 so all fields are fixed size
+**       and the layout must only change with SHM42_VERSION.
+**    6. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _shm42_
+#define _shm42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SHM42_MAGIC     0x42534D34   /* "42MS" when viewed little-endian */
+#define SHM42_VERSION   1
+
+#define SHM42_RING_LEN  16384        /* Must be a power of 2 */
+
+#define SHM42_NAME_LEN  32
+
+/*
+** Event Message IDs
+*/
+
+#define SHM42_OPEN_EID   (SHM42_BASE_EID + 0)
+#define SHM42_CLOSE_EID  (SHM42_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Shared memory segment, see notes 3 and 5
+*/
+
+typedef struct
+{
+
+   uint32  Head;       /* Producer's free running byte count */
+   uint32  Tail;       /* Consumer's free running byte count */
+   uint32  Doorbell;   /* Futex word, incremented by the producer after each write */
+   uint32  Waiting;    /* Non-zero while the consumer is pending on Doorbell */
+   uint8   Data[SHM42_RING_LEN];
+
+} SHM42_Ring_t;
+
+typedef struct
+{
+
+   uint32  Magic;            /* Written last by the server */
+   uint32  Version;
+   uint32  RingLen;
+   uint32  ServerClosed;     /* Set by the server when it stops serving the segment */
+   uint32  ClientSession;    /* Incremented by the client when it opens and closes the segment */
+   uint32  Spare[3];
+
+   SHM42_Ring_t  SensorRing;     /* 42 to interface */
+   SHM42_Ring_t  ActuatorRing;   /* Interface to 42 */
+
+} SHM42_Segment_t;
+
+
+/******************************************************************************
+** SHM42 Class
+*/
+
+typedef struct
+{
+
+   bool    Open;
+   bool    Server;
+   int     Fd;
+   char    Name[SHM42_NAME_LEN];
+
+   SHM42_Segment_t *Segment;
+   SHM42_Ring_t    *RxRing;
+   SHM42_Ring_t    *TxRing;
+
+   uint32  ReadCnt;     /* Reads that returned data */
+   uint32  WaitCnt;     /* Reads that pended on the doorbell */
+   uint32  WakeCnt;     /* Writes that woke a waiting consumer */
+
+} SHM42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SHM42_Constructor
+**
+*/
+void SHM42_Constructor(SHM42_Class_t *Shm42);
+
+
+/******************************************************************************
+** Function: SHM42_Close
+**
+** Unmap the segment. A client notifies the server and a server marks the
+** segment closed and removes its name.
+**
+*/
+void SHM42_Close(SHM42_Class_t *Shm42);
+
+
+/******************************************************************************
+** Function: SHM42_Create
+**
+** Create, initialize and map a segment as the server. Used by 42 side test
+** peers, the interface only opens segments.
+**
+*/
+bool SHM42_Create(SHM42_Class_t *Shm42, const char *Name);
+
+
+/******************************************************************************
+** Function: SHM42_Open
+**
+** Map an existing segment as the client. Fails if the server hasn't
+** initialized the segment or it has a different version. Data the server
+** wrote before the open is discarded.
+**
+*/
+bool SHM42_Open(SHM42_Class_t *Shm42, const char *Name);
+
+
+/******************************************************************************
+** Function: SHM42_Read
+**
+** Copy up to Len received bytes. If none are available the read pends up to
+** Timeout milliseconds (OS_PEND to wait forever).
+**
+** Notes:
+**   1. Returns the number of bytes copied, OS_ERROR_TIMEOUT if none arrived,
+**      or zero if the peer closed the segment, matching OS_TimedRead().
+**
+*/
+int32 SHM42_Read(SHM42_Class_t *Shm42, void *Buf, uint32 Len, int32 Timeout);
+
+
+/******************************************************************************
+** Function: SHM42_Readable
+**
+** Return true if a read wouldn't pend, data is queued or the peer closed.
+**
+*/
+bool SHM42_Readable(const SHM42_Class_t *Shm42);
+
+
+/******************************************************************************
+** Function: SHM42_Wait
+**
+** Pend up to Timeout milliseconds (OS_PEND to wait forever) until the
+** segment is readable. Returns false on a timeout.
+**
+*/
+bool SHM42_Wait(SHM42_Class_t *Shm42, int32 Timeout);
+
+
+/******************************************************************************
+** Function: SHM42_Write
+**
+** Copy Len bytes into the transmit ring and wake the peer if it's waiting.
+**
+** Notes:
+**   1. The write never pends. Returns Len, or OS_QUEUE_FULL without
+**      writing anything if the ring doesn't have room for all of Len.
+**
+*/
+int32 SHM42_Write(SHM42_Class_t *Shm42, const void *Buf, uint32 Len);
+
+
+#endif /* _shm42_ */
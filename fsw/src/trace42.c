@@ -0,0 +1,140 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Record a compact binary trace of the 42 interface control cycle
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "trace42.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TRACE42_INDEX(Count)  ((Count) & (TRACE42_REC_CNT-1))
+
+
+/******************************************************************************
+** Function: TRACE42_Constructor
+**
+*/
+void TRACE42_Constructor(TRACE42_Class_t *Trace42)
+{
+
+   CFE_PSP_MemSet((void*)Trace42, 0, sizeof(TRACE42_Class_t));
+
+} /* End TRACE42_Constructor() */
+
+
+/******************************************************************************
+** Function: TRACE42_Dump
+**
+*/
+bool TRACE42_Dump(const TRACE42_Class_t *Trace42, const char *Filename)
+{
+
+   bool    RetStatus = false;
+   int32   SysStatus;
+   int32   WriteLen;
+   uint32  i, First;
+   osal_id_t          FileHandle;
+   CFE_FS_Header_t    CfeHdr;
+   TRACE42_FileHdr_t  FileHdr;
+
+   FileHdr.Version  = TRACE42_FILE_VERSION;
+   FileHdr.RecLen   = sizeof(TRACE42_Rec_t);
+   FileHdr.TotalCnt = __atomic_load_n(&Trace42->RecCnt, __ATOMIC_ACQUIRE);
+   FileHdr.RecCnt   = (FileHdr.TotalCnt < TRACE42_REC_CNT) ? FileHdr.TotalCnt : TRACE42_REC_CNT;
+   First = FileHdr.TotalCnt - FileHdr.RecCnt;
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      CFE_FS_InitHeader(&CfeHdr, "BC42 Interface Cycle Trace", TRACE42_FILE_SUBTYPE);
+      WriteLen = CFE_FS_WriteHeader(FileHandle, &CfeHdr);
+
+      if (WriteLen == sizeof(CFE_FS_Header_t))
+      {
+
+         WriteLen = OS_write(FileHandle, &FileHdr, sizeof(TRACE42_FileHdr_t));
+         RetStatus = (WriteLen == sizeof(TRACE42_FileHdr_t));
+
+         for (i=0; (i < FileHdr.RecCnt) && RetStatus; i++)
+         {
+            WriteLen = OS_write(FileHandle, &Trace42->Rec[TRACE42_INDEX(First + i)], sizeof(TRACE42_Rec_t));
+            RetStatus = (WriteLen == sizeof(TRACE42_Rec_t));
+         }
+
+      }
+
+      OS_close(FileHandle);
+
+      if (RetStatus)
+      {
+         CFE_EVS_SendEvent(TRACE42_DUMP_EID, CFE_EVS_EventType_INFORMATION,
+                           "Wrote %d of %d trace records to %s",
+                           FileHdr.RecCnt, FileHdr.TotalCnt, Filename);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(TRACE42_DUMP_EID, CFE_EVS_EventType_ERROR,
+                           "Error writing trace file %s. Status=%d", Filename, WriteLen);
+      }
+
+   }
+   else
+   {
+      CFE_EVS_SendEvent(TRACE42_DUMP_EID, CFE_EVS_EventType_ERROR,
+                        "Error creating trace file %s. Status=%d", Filename, SysStatus);
+   }
+
+   return RetStatus;
+
+} /* End TRACE42_Dump() */
+
+
+/******************************************************************************
+** Function: TRACE42_Record
+**
+*/
+void TRACE42_Record(TRACE42_Class_t *Trace42, uint16 Id, uint32 Cycle,
+                    uint16 Arg0, uint32 Arg1, uint32 Arg2)
+{
+
+   OS_time_t      Time;
+   TRACE42_Rec_t  *Rec;
+
+   CFE_PSP_GetTime(&Time);
+   
+   Rec = &Trace42->Rec[TRACE42_INDEX(__atomic_fetch_add(&Trace42->RecCnt, 1, __ATOMIC_RELAXED))];
+
+   Rec->TimeUsec = OS_TimeGetTotalMicroseconds(Time);
+   Rec->Cycle    = Cycle;
+   Rec->Id       = Id;
+   Rec->Arg0     = Arg0;
+   Rec->Arg1     = Arg1;
+   Rec->Arg2     = Arg2;
+
+} /* End TRACE42_Record() */
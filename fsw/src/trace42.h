@@ -0,0 +1,132 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Record a compact binary trace of the 42 interface control cycle
+**
+**  Notes:
+**    1. Records are written to a fixed size ring so the most recent
+**       TRACE42_REC_CNT records are always available. Recording a record is
+**       a timestamp and a few stores so it can be left enabled in the
+**       control cycle's critical path. The ring is written to a file on
+**       command for post-mortem analysis.
+**    2. Records may be made from multiple tasks. Each record's slot is
+**       reserved with an atomic increment so concurrent records don't
+**       overwrite each other. A dump made while records are being added may
+**       contain a partially updated record at the newest end of the trace.
+**    3. The record identifier and arguments are defined by the user. The
+**       dump file is a cFE file header, a TRACE42_FileHdr_t, and the records
+**       in oldest to newest order, all in the processor's native byte order.
+**    4. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _trace42_
+#define _trace42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TRACE42_REC_CNT        1024   /* Must be a power of 2 */
+#define TRACE42_FILE_VERSION   1
+#define TRACE42_FILE_SUBTYPE   (CFE_FS_SubType_USER_BASE + 0x42)
+
+/*
+** Event Message IDs
+*/
+
+#define TRACE42_DUMP_EID  (TRACE42_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   int64   TimeUsec;    /* CFE_PSP_GetTime() in microseconds */
+   uint32  Cycle;       
+   uint32  Arg1;
+   uint32  Arg2;
+   uint16  Id;
+   uint16  Arg0;
+
+} TRACE42_Rec_t;
+
+
+typedef struct
+{
+
+   uint32  Version;
+   uint32  RecLen;      /* sizeof(TRACE42_Rec_t) */
+   uint32  RecCnt;      /* Records that follow this header */
+   uint32  TotalCnt;    /* Records made since the trace was cleared */
+
+} TRACE42_FileHdr_t;
+
+
+/******************************************************************************
+** TRACE42 Class
+*/
+
+typedef struct
+{
+
+   uint32         RecCnt;     /* Free running count, next record's slot */
+   TRACE42_Rec_t  Rec[TRACE42_REC_CNT];
+
+} TRACE42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TRACE42_Constructor
+**
+*/
+void TRACE42_Constructor(TRACE42_Class_t *Trace42);
+
+
+/******************************************************************************
+** Function: TRACE42_Dump
+**
+** Write the trace records to a file.
+**
+*/
+bool TRACE42_Dump(const TRACE42_Class_t *Trace42, const char *Filename);
+
+
+/******************************************************************************
+** Function: TRACE42_Record
+**
+** Add a timestamped record to the trace.
+**
+*/
+void TRACE42_Record(TRACE42_Class_t *Trace42, uint16 Id, uint32 Cycle,
+                    uint16 Arg0, uint32 Arg1, uint32 Arg2);
+
+
+#endif /* _trace42_ */
@@ -0,0 +1,909 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Provide a binary framed wire protocol for the 42 socket link
+**
+**  Notes:
+**    1. See wire42.h for the frame definitions.
+**    2. Values are serialized a byte at a time so the code is independent of
+**       the host's byte order and structure packing.
+**    3. The receive ring's head and tail are free running byte counts so the
+**       number of buffered bytes is always (RxHead - RxTail) and indices are
+**       masked with the power of 2 ring length.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "wire42.h"
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint8 *PutUint16(uint8 *Buf, uint16 Value);
+static uint8 *PutUint32(uint8 *Buf, uint32 Value);
+static uint8 *PutDouble(uint8 *Buf, double Value);
+static uint8 *PutDoubles(uint8 *Buf, const double *Value, uint16 Cnt);
+static const uint8 *GetUint16(const uint8 *Buf, uint16 *Value);
+static const uint8 *GetUint32(const uint8 *Buf, uint32 *Value);
+static const uint8 *GetDouble(const uint8 *Buf, double *Value);
+static const uint8 *GetDoubles(const uint8 *Buf, double *Value, uint16 Cnt);
+static const uint8 *GetSensorDoubles(const uint8 *Buf, double *Value, uint16 Cnt, bool Enabled);
+
+static uint8 *EncodeActuator(uint8 *Buf, const WIRE42_ActuatorFrame_t *ActuatorFrame);
+static uint8 *EncodeHeader(WIRE42_Class_t *Wire42, uint8 *Buf, uint8 Type, uint32 Length);
+static bool DecodeHeader(const uint8 *Buf, uint8 *Type, uint32 *FrameLen);
+static bool ExpectedFrame(WIRE42_Class_t *Wire42, uint8 ExpectedType, uint32 ExpectedLength);
+static int32 FillRing(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout);
+static bool ParseFrame(WIRE42_Class_t *Wire42);
+static void PeekRing(const WIRE42_Class_t *Wire42, uint32 Offset, uint8 *Buf, uint32 Len);
+static int32 RecvDatagram(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout);
+static int32 RecvFrame(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout,
+                       uint8 ExpectedType, uint32 ExpectedLength);
+static bool SendAll(WIRE42_Class_t *Wire42, osal_id_t SocketId, const uint8 *Buf, uint32 Len);
+
+
+/******************************************************************************
+** Function: WIRE42_Constructor
+**
+*/
+void WIRE42_Constructor(WIRE42_Class_t *Wire42)
+{
+
+   CFE_PSP_MemSet((void*)Wire42, 0, sizeof(WIRE42_Class_t));
+
+   Wire42->Protocol   = WIRE42_PROTOCOL_ASCII;
+   Wire42->SensorMask = WIRE42_SENSOR_ALL;
+
+} /* End WIRE42_Constructor() */
+
+
+/******************************************************************************
+** Function: WIRE42_FramesQueued
+**
+** Notes:
+**   1. Only complete frames with valid headers are counted. Counting stops at
+**      the first partial or malformed frame.
+*/
+uint16 WIRE42_FramesQueued(const WIRE42_Class_t *Wire42)
+{
+
+   uint16 FrameCnt = 0;
+   uint32 Offset   = 0;
+   uint32 Used     = Wire42->RxHead - Wire42->RxTail;
+   uint32 FrameLen;
+   uint8  Type;
+   uint8  Hdr[WIRE42_HDR_LEN];
+
+   while ((Used - Offset) >= WIRE42_HDR_LEN)
+   {
+
+      PeekRing(Wire42, Offset, Hdr, WIRE42_HDR_LEN);
+      if (!DecodeHeader(Hdr, &Type, &FrameLen) || ((Used - Offset) < FrameLen))
+      {
+         break;
+      }
+      ++FrameCnt;
+      Offset += FrameLen;
+
+   }
+
+   return FrameCnt;
+
+} /* End WIRE42_FramesQueued() */
+
+
+/******************************************************************************
+** Function: WIRE42_Negotiate
+**
+** Notes:
+**   1. The hello payload contains the sensor and actuator payload lengths so
+**      the peer can detect a frame layout mismatch. The acknowledgement must
+**      echo the same lengths.
+**
+*/
+bool WIRE42_Negotiate(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout)
+{
+
+   uint8  *Buf;
+   uint32 SensorLen   = 0;
+   uint32 ActuatorLen = 0;
+
+   Wire42->Protocol = WIRE42_PROTOCOL_ASCII;
+   Wire42->TxSeq = 0;
+   Wire42->TxLen = 0;
+   Wire42->RxSeq = 0;
+   Wire42->RxSeqValid = false;
+
+   Wire42->RxState  = WIRE42_RX_STATE_HEADER;
+   Wire42->RxResync = false;
+   Wire42->RxHead   = 0;
+   Wire42->RxTail   = 0;
+
+   Buf = EncodeHeader(Wire42, Wire42->TxBuf, WIRE42_FRAME_HELLO, WIRE42_HELLO_PAYLOAD_LEN);
+   Buf = PutUint32(Buf, WIRE42_SENSOR_PAYLOAD_LEN);
+   Buf = PutUint32(Buf, WIRE42_ACTUATOR_PAYLOAD_LEN);
+
+   if (!SendAll(Wire42, SocketId, Wire42->TxBuf, (uint32)(Buf - Wire42->TxBuf)))
+   {
+      CFE_EVS_SendEvent(WIRE42_NEGOTIATE_EID, CFE_EVS_EventType_ERROR,
+                        "Binary protocol negotiation failed. Error sending hello frame");
+      return false;
+   }
+
+   if (RecvFrame(Wire42, SocketId, Timeout, WIRE42_FRAME_HELLO_ACK, WIRE42_HELLO_PAYLOAD_LEN) > 0)
+   {
+
+      GetUint32(GetUint32(&Wire42->RxBuf[WIRE42_HDR_LEN], &SensorLen), &ActuatorLen);
+
+      if ((SensorLen == WIRE42_SENSOR_PAYLOAD_LEN) && (ActuatorLen == WIRE42_ACTUATOR_PAYLOAD_LEN))
+      {
+         Wire42->Protocol = WIRE42_PROTOCOL_BINARY;
+         CFE_EVS_SendEvent(WIRE42_NEGOTIATE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Binary protocol version %d negotiated with 42", WIRE42_VERSION);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(WIRE42_NEGOTIATE_EID, CFE_EVS_EventType_ERROR,
+                           "Binary protocol negotiation failed. 42 frame lengths sensor=%d, actuator=%d don't match expected %d, %d",
+                           (int)SensorLen, (int)ActuatorLen, WIRE42_SENSOR_PAYLOAD_LEN, WIRE42_ACTUATOR_PAYLOAD_LEN);
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent(WIRE42_NEGOTIATE_EID, CFE_EVS_EventType_ERROR,
+                        "Binary protocol negotiation failed. No valid acknowledgement received within %d ms",
+                        (int)Timeout);
+   }
+
+   return (Wire42->Protocol == WIRE42_PROTOCOL_BINARY);
+
+} /* End WIRE42_Negotiate() */
+
+
+/******************************************************************************
+** Function: WIRE42_ParseProtocol
+**
+*/
+WIRE42_Protocol_t WIRE42_ParseProtocol(const char *ProtocolStr)
+{
+
+   WIRE42_Protocol_t Protocol = WIRE42_PROTOCOL_ASCII;
+
+   if (strcmp(ProtocolStr, WIRE42_PROTOCOL_BINARY_STR) == 0)
+   {
+      Protocol = WIRE42_PROTOCOL_BINARY;
+   }
+
+   return Protocol;
+
+} /* End WIRE42_ParseProtocol() */
+
+
+/******************************************************************************
+** Function: WIRE42_RecvSensorFrame
+**
+*/
+int32 WIRE42_RecvSensorFrame(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout,
+                             WIRE42_SensorFrame_t *SensorFrame)
+{
+
+   int32  RetStatus;
+   uint32 Flags;
+   uint16 Mask = Wire42->SensorMask;
+   const uint8 *Buf;
+
+   RetStatus = RecvFrame(Wire42, SocketId, Timeout, WIRE42_FRAME_SENSOR, WIRE42_SENSOR_PAYLOAD_LEN);
+   if (RetStatus > 0)
+   {
+
+      Buf = &Wire42->RxBuf[WIRE42_HDR_LEN];
+      Buf = GetUint32(Buf, &Flags);
+      Buf = GetDouble(Buf, &SensorFrame->Time);
+      Buf = GetSensorDoubles(Buf, SensorFrame->PosN, 3, (Mask & WIRE42_SENSOR_GPS));
+      Buf = GetSensorDoubles(Buf, SensorFrame->VelN, 3, (Mask & WIRE42_SENSOR_GPS));
+      Buf = GetSensorDoubles(Buf, SensorFrame->qbn,  4, (Mask & WIRE42_SENSOR_ST));
+      Buf = GetSensorDoubles(Buf, SensorFrame->wbn,  3, (Mask & WIRE42_SENSOR_GYRO));
+      Buf = GetSensorDoubles(Buf, SensorFrame->svb,  3, (Mask & WIRE42_SENSOR_SUN));
+      Buf = GetSensorDoubles(Buf, SensorFrame->bvb,  3, (Mask & WIRE42_SENSOR_MAG));
+      GetSensorDoubles(Buf, SensorFrame->WhlH, 4, (Mask & WIRE42_SENSOR_WHL));
+
+      SensorFrame->SunValid = ((Flags & WIRE42_SENSOR_FLAG_SUN_VALID) != 0) && ((Mask & WIRE42_SENSOR_SUN) != 0);
+
+      ++Wire42->RxFrameCnt;
+      RetStatus = WIRE42_HDR_LEN + WIRE42_SENSOR_PAYLOAD_LEN;
+
+   }
+
+   return RetStatus;
+
+} /* End WIRE42_RecvSensorFrame() */
+
+
+/******************************************************************************
+** Function: WIRE42_ResendActuator
+**
+*/
+bool WIRE42_ResendActuator(WIRE42_Class_t *Wire42, osal_id_t SocketId)
+{
+
+   bool RetStatus = false;
+
+   if (Wire42->TxLen > 0)
+   {
+      RetStatus = SendAll(Wire42, SocketId, Wire42->TxBuf, Wire42->TxLen);
+      if (RetStatus)
+      {
+         ++Wire42->TxResendCnt;
+      }
+   }
+
+   return RetStatus;
+
+} /* End WIRE42_ResendActuator() */
+
+
+/******************************************************************************
+** Function: WIRE42_ResetStatus
+**
+*/
+void WIRE42_ResetStatus(WIRE42_Class_t *Wire42)
+{
+
+   Wire42->RxFrameCnt    = 0;
+   Wire42->RxFrameErrCnt = 0;
+   Wire42->RxReadCnt     = 0;
+   Wire42->RxDiscardCnt  = 0;
+   Wire42->RxStaleCnt    = 0;
+   Wire42->RxLostCnt     = 0;
+   Wire42->TxResendCnt   = 0;
+
+} /* End WIRE42_ResetStatus() */
+
+
+/******************************************************************************
+** Function: WIRE42_Resync
+**
+*/
+uint32 WIRE42_Resync(WIRE42_Class_t *Wire42)
+{
+
+   uint32 DiscardLen = Wire42->RxHead - Wire42->RxTail;
+
+   Wire42->RxTail        = Wire42->RxHead;
+   Wire42->RxState       = WIRE42_RX_STATE_HEADER;
+   Wire42->RxResync      = true;
+   Wire42->RxDiscardCnt += DiscardLen;
+
+   return DiscardLen;
+
+} /* End WIRE42_Resync() */
+
+
+/******************************************************************************
+** Function: WIRE42_SendActuatorBatch
+**
+*/
+bool WIRE42_SendActuatorBatch(WIRE42_Class_t *Wire42, osal_id_t SocketId,
+                              const WIRE42_ActuatorFrame_t *ActuatorFrame, uint16 Steps)
+{
+
+   uint8  *Buf;
+   uint16 i;
+   bool   RetStatus;
+
+   if ((Steps < 1) || (Steps > WIRE42_BATCH_MAX))
+   {
+      CFE_EVS_SendEvent(WIRE42_SEND_FRAME_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid actuator batch of %d steps, must be between 1 and %d",
+                        Steps, WIRE42_BATCH_MAX);
+      return false;
+   }
+
+   Buf = EncodeHeader(Wire42, Wire42->TxBuf, WIRE42_FRAME_ACTUATOR_BATCH, WIRE42_ACTUATOR_BATCH_PAYLOAD_LEN(Steps));
+   Buf = PutUint32(Buf, Steps);
+   for (i=0; i < Steps; i++)
+   {
+      Buf = EncodeActuator(Buf, &ActuatorFrame[i]);
+   }
+
+   Wire42->TxLen = (uint32)(Buf - Wire42->TxBuf);
+   RetStatus = SendAll(Wire42, SocketId, Wire42->TxBuf, Wire42->TxLen);
+
+   if (!RetStatus)
+   {
+      CFE_EVS_SendEvent(WIRE42_SEND_FRAME_EID, CFE_EVS_EventType_ERROR,
+                        "Error writing %d step actuator batch frame %d to socket", Steps, (int)(Wire42->TxSeq-1));
+   }
+
+   return RetStatus;
+
+} /* End WIRE42_SendActuatorBatch() */
+
+
+/******************************************************************************
+** Function: WIRE42_SendActuatorFrame
+**
+*/
+bool WIRE42_SendActuatorFrame(WIRE42_Class_t *Wire42, osal_id_t SocketId,
+                              const WIRE42_ActuatorFrame_t *ActuatorFrame)
+{
+
+   uint8 *Buf;
+   bool  RetStatus;
+
+   Buf = EncodeHeader(Wire42, Wire42->TxBuf, WIRE42_FRAME_ACTUATOR, WIRE42_ACTUATOR_PAYLOAD_LEN);
+   Buf = EncodeActuator(Buf, ActuatorFrame);
+
+   Wire42->TxLen = (uint32)(Buf - Wire42->TxBuf);
+   RetStatus = SendAll(Wire42, SocketId, Wire42->TxBuf, Wire42->TxLen);
+
+   if (!RetStatus)
+   {
+      CFE_EVS_SendEvent(WIRE42_SEND_FRAME_EID, CFE_EVS_EventType_ERROR,
+                        "Error writing actuator frame %d to socket", (int)(Wire42->TxSeq-1));
+   }
+
+   return RetStatus;
+
+} /* End WIRE42_SendActuatorFrame() */
+
+
+/******************************************************************************
+** Function: EncodeActuator
+**
+** Returns a pointer to the byte following the actuator payload.
+*/
+static uint8 *EncodeActuator(uint8 *Buf, const WIRE42_ActuatorFrame_t *ActuatorFrame)
+{
+
+   Buf = PutDoubles(Buf, ActuatorFrame->Tcmd, 3);
+   Buf = PutDoubles(Buf, ActuatorFrame->Mcmd, 3);
+
+   return PutDouble(Buf, ActuatorFrame->SaGcmd);
+
+} /* End EncodeActuator() */
+
+
+/******************************************************************************
+** Function: EncodeHeader
+**
+** Returns a pointer to the start of the frame's payload. In datagram mode
+** actuator frames carry the last accepted sensor frame's Seq.
+*/
+static uint8 *EncodeHeader(WIRE42_Class_t *Wire42, uint8 *Buf, uint8 Type, uint32 Length)
+{
+
+   Buf = PutUint16(Buf, WIRE42_SYNC);
+   *Buf++ = WIRE42_VERSION;
+   *Buf++ = Type;
+   Buf = PutUint32(Buf, Length);
+   Buf = PutUint32(Buf, (Wire42->Datagram && (Type != WIRE42_FRAME_HELLO)) ? Wire42->RxSeq : Wire42->TxSeq);
+   ++Wire42->TxSeq;
+
+   return Buf;
+
+} /* End EncodeHeader() */
+
+
+/******************************************************************************
+** Function: DecodeHeader
+**
+** Returns true if the header is valid. FrameLen includes the header.
+*/
+static bool DecodeHeader(const uint8 *Buf, uint8 *Type, uint32 *FrameLen)
+{
+
+   uint16 Sync;
+   uint32 Length;
+
+   GetUint16(Buf, &Sync);
+   GetUint32(&Buf[4], &Length);
+
+   *Type     = Buf[3];
+   *FrameLen = WIRE42_HDR_LEN + Length;
+
+   return ((Sync == WIRE42_SYNC) && (Buf[2] == WIRE42_VERSION) &&
+           (*Type >= WIRE42_FRAME_HELLO) && (*Type <= WIRE42_FRAME_ACTUATOR) &&
+           (Length <= (WIRE42_MAX_FRAME_LEN - WIRE42_HDR_LEN)));
+
+} /* End DecodeHeader() */
+
+
+/******************************************************************************
+** Function: ExpectedFrame
+**
+** Return true if the frame in RxBuf has the expected type and length,
+** otherwise count and report the discarded frame.
+*/
+static bool ExpectedFrame(WIRE42_Class_t *Wire42, uint8 ExpectedType, uint32 ExpectedLength)
+{
+
+   if ((Wire42->RxFrameType == ExpectedType) &&
+       (Wire42->RxFrameLen == (WIRE42_HDR_LEN + ExpectedLength)))
+   {
+      return true;
+   }
+
+   ++Wire42->RxFrameErrCnt;
+   CFE_EVS_SendEvent(WIRE42_RECV_FRAME_EID, CFE_EVS_EventType_ERROR,
+                     "Discarded frame %d with type %d, length %d. Expected type %d, length %d",
+                     (int)Wire42->RxSeq, Wire42->RxFrameType, (int)(Wire42->RxFrameLen - WIRE42_HDR_LEN),
+                     ExpectedType, (int)ExpectedLength);
+
+   return false;
+
+} /* End ExpectedFrame() */
+
+
+/******************************************************************************
+** Function: FillRing
+**
+** Read whatever is available into the ring's contiguous free space. The read
+** pends up to Timeout for the first byte.
+*/
+static int32 FillRing(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout)
+{
+
+   int32  Status;
+   uint32 Start = Wire42->RxHead & (WIRE42_RX_RING_LEN - 1);
+   uint32 Free  = WIRE42_RX_RING_LEN - (Wire42->RxHead - Wire42->RxTail);
+   uint32 Len   = WIRE42_RX_RING_LEN - Start;
+
+   if (Len > Free)
+   {
+      Len = Free;
+   }
+
+   if (Len == 0)
+   {
+      /* Can't occur since a frame is always shorter than the ring */
+      return OS_ERROR;
+   }
+
+   if (Wire42->Shm42 != NULL)
+   {
+      Status = SHM42_Read(Wire42->Shm42, &Wire42->RxRing[Start], Len, Timeout);
+   }
+   else
+   {
+      Status = OS_TimedRead(SocketId, &Wire42->RxRing[Start], Len, Timeout);
+   }
+   if (Status > 0)
+   {
+      Wire42->RxHead += Status;
+      ++Wire42->RxReadCnt;
+   }
+
+   return Status;
+
+} /* End FillRing() */
+
+
+/******************************************************************************
+** Function: ParseFrame
+**
+** Advance the incremental parser. Returns true when a complete frame has been
+** removed from the ring and copied to RxBuf.
+**
+** Notes:
+**   1. A byte is discarded when the data at the ring tail isn't a valid
+**      header so the parser resynchronizes on the next frame.
+*/
+static bool ParseFrame(WIRE42_Class_t *Wire42)
+{
+
+   uint32 Used;
+
+   while (true)
+   {
+
+      Used = Wire42->RxHead - Wire42->RxTail;
+
+      if (Wire42->RxState == WIRE42_RX_STATE_HEADER)
+      {
+
+         if (Used < WIRE42_HDR_LEN)
+         {
+            return false;
+         }
+
+         PeekRing(Wire42, 0, Wire42->RxBuf, WIRE42_HDR_LEN);
+         if (DecodeHeader(Wire42->RxBuf, &Wire42->RxFrameType, &Wire42->RxFrameLen))
+         {
+            Wire42->RxState  = WIRE42_RX_STATE_PAYLOAD;
+            Wire42->RxResync = false;
+         }
+         else
+         {
+            if (!Wire42->RxResync)
+            {
+               Wire42->RxResync = true;
+               ++Wire42->RxFrameErrCnt;
+               CFE_EVS_SendEvent(WIRE42_RECV_FRAME_EID, CFE_EVS_EventType_ERROR,
+                                 "Invalid frame header after frame %d, resynchronizing stream", (int)Wire42->RxSeq);
+            }
+            ++Wire42->RxTail;
+            ++Wire42->RxDiscardCnt;
+            continue;
+         }
+
+      } /* End if RX_STATE_HEADER */
+
+      if (Used < Wire42->RxFrameLen)
+      {
+         return false;
+      }
+
+      PeekRing(Wire42, 0, Wire42->RxBuf, Wire42->RxFrameLen);
+      Wire42->RxTail += Wire42->RxFrameLen;
+      Wire42->RxState = WIRE42_RX_STATE_HEADER;
+      GetUint32(&Wire42->RxBuf[8], &Wire42->RxSeq);
+
+      return true;
+
+   } /* End while */
+
+} /* End ParseFrame() */
+
+
+/******************************************************************************
+** Function: PeekRing
+**
+** Copy bytes starting at an offset from the ring tail without consuming them.
+*/
+static void PeekRing(const WIRE42_Class_t *Wire42, uint32 Offset, uint8 *Buf, uint32 Len)
+{
+
+   uint32 Start = (Wire42->RxTail + Offset) & (WIRE42_RX_RING_LEN - 1);
+   uint32 FirstLen = WIRE42_RX_RING_LEN - Start;
+
+   if (FirstLen >= Len)
+   {
+      memcpy(Buf, &Wire42->RxRing[Start], Len);
+   }
+   else
+   {
+      memcpy(Buf, &Wire42->RxRing[Start], FirstLen);
+      memcpy(&Buf[FirstLen], Wire42->RxRing, Len - FirstLen);
+   }
+
+} /* End PeekRing() */
+
+
+/******************************************************************************
+** Function: RecvDatagram
+**
+** Read datagrams until one holds a valid frame that is newer than the last
+** accepted frame and copy it to RxBuf.
+**
+** Notes:
+**   1. Returns 1 when a frame is in RxBuf, otherwise the socket read status
+**      that stopped the receive.
+**   2. Seq comparisons use serial number arithmetic so they survive the
+**      uint32 wrap.
+**   3. Timeout covers the whole receive. Each read waits for the time left
+**      so a stream of stale or invalid datagrams can't extend it.
+**   4. A hello or hello acknowledgement starts a new Seq sequence unless it
+**      duplicates the last accepted frame's Seq, and a Seq more than
+**      WIRE42_RX_SEQ_RESTART behind the last accepted frame is taken as a
+**      restarted peer, so a peer restart isn't discarded as stale until its
+**      Seq catches up.
+*/
+static int32 RecvDatagram(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout)
+{
+
+   int32     Status;
+   int32     ReadTimeout = Timeout;
+   int64     RemainingMsec;
+   uint32    Seq;
+   OS_time_t Deadline;
+   OS_time_t Now;
+
+   if (Timeout > 0)
+   {
+      CFE_PSP_GetTime(&Deadline);
+      Deadline = OS_TimeAdd(Deadline, OS_TimeFromTotalMilliseconds(Timeout));
+   }
+
+   while (true)
+   {
+
+      Status = OS_TimedRead(SocketId, Wire42->RxBuf, sizeof(Wire42->RxBuf), ReadTimeout);
+      if (Status <= 0)
+      {
+         return Status;
+      }
+      ++Wire42->RxReadCnt;
+
+      if (Timeout > 0)
+      {
+         CFE_PSP_GetTime(&Now);
+         RemainingMsec = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Deadline, Now));
+         ReadTimeout   = (RemainingMsec > 0) ? (int32)RemainingMsec : 0;
+      }
+
+      if (!DecodeHeader(Wire42->RxBuf, &Wire42->RxFrameType, &Wire42->RxFrameLen) ||
+          (Wire42->RxFrameLen != (uint32)Status))
+      {
+         ++Wire42->RxFrameErrCnt;
+         Wire42->RxDiscardCnt += Status;
+         CFE_EVS_SendEvent(WIRE42_RECV_FRAME_EID, CFE_EVS_EventType_ERROR,
+                           "Discarded %d byte datagram without a valid frame after frame %d",
+                           (int)Status, (int)Wire42->RxSeq);
+         continue;
+      }
+
+      GetUint32(&Wire42->RxBuf[8], &Seq);
+      if ((((Wire42->RxFrameType == WIRE42_FRAME_HELLO) || (Wire42->RxFrameType == WIRE42_FRAME_HELLO_ACK)) &&
+           (Seq != Wire42->RxSeq)) || ((int32)(Wire42->RxSeq - Seq) > WIRE42_RX_SEQ_RESTART))
+      {
+         Wire42->RxSeqValid = false;
+      }
+      if (Wire42->RxSeqValid)
+      {
+         if ((int32)(Seq - Wire42->RxSeq) <= 0)
+         {
+            ++Wire42->RxStaleCnt;
+            continue;
+         }
+         Wire42->RxLostCnt += Seq - Wire42->RxSeq - 1;
+      }
+      Wire42->RxSeq      = Seq;
+      Wire42->RxSeqValid = true;
+
+      return 1;
+
+   } /* End while */
+
+} /* End RecvDatagram() */
+
+
+/******************************************************************************
+** Function: RecvFrame
+**
+** Parse frames from the ring, reading more data as needed, until a frame of
+** the expected type is in RxBuf. Frames of other types are discarded.
+**
+** Notes:
+**   1. Returns 1 when a frame is in RxBuf, otherwise the socket read status
+**      that stopped the receive.
+**   2. In datagram mode each read is a whole frame and the ring isn't used.
+*/
+static int32 RecvFrame(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout,
+                       uint8 ExpectedType, uint32 ExpectedLength)
+{
+
+   int32 Status;
+
+   while (true)
+   {
+
+      if (Wire42->Datagram)
+      {
+         Status = RecvDatagram(Wire42, SocketId, Timeout);
+         if (Status <= 0)
+         {
+            return Status;
+         }
+         if (ExpectedFrame(Wire42, ExpectedType, ExpectedLength))
+         {
+            return 1;
+         }
+         continue;
+      }
+
+      while (ParseFrame(Wire42))
+      {
+         if (ExpectedFrame(Wire42, ExpectedType, ExpectedLength))
+         {
+            return 1;
+         }
+      }
+
+      Status = FillRing(Wire42, SocketId, Timeout);
+      if (Status <= 0)
+      {
+         return Status;
+      }
+
+   } /* End while */
+
+} /* End RecvFrame() */
+
+
+/******************************************************************************
+** Function: SendAll
+**
+** A shared memory write copies the whole frame or fails.
+*/
+static bool SendAll(WIRE42_Class_t *Wire42, osal_id_t SocketId, const uint8 *Buf, uint32 Len)
+{
+
+   int32  Status;
+   uint32 BytesWritten = 0;
+
+   if (Wire42->Shm42 != NULL)
+   {
+      return (SHM42_Write(Wire42->Shm42, Buf, Len) == (int32)Len);
+   }
+
+   while (BytesWritten < Len)
+   {
+
+      Status = OS_TimedWrite(SocketId, &Buf[BytesWritten], Len - BytesWritten, OS_PEND);
+      if (Status <= 0)
+      {
+         return false;
+      }
+      BytesWritten += Status;
+
+   }
+
+   return true;
+
+} /* End SendAll() */
+
+
+/******************************************************************************
+** Functions: Little-endian serialization
+**
+*/
+static uint8 *PutUint16(uint8 *Buf, uint16 Value)
+{
+
+   *Buf++ = (uint8)(Value & 0xFF);
+   *Buf++ = (uint8)(Value >> 8);
+
+   return Buf;
+
+} /* End PutUint16() */
+
+
+static uint8 *PutUint32(uint8 *Buf, uint32 Value)
+{
+
+   int i;
+
+   for (i=0; i < 4; i++)
+   {
+      *Buf++ = (uint8)(Value >> (8*i));
+   }
+
+   return Buf;
+
+} /* End PutUint32() */
+
+
+static uint8 *PutDouble(uint8 *Buf, double Value)
+{
+
+   int    i;
+   uint64 Bits;
+
+   memcpy(&Bits, &Value, sizeof(Bits));
+   for (i=0; i < 8; i++)
+   {
+      *Buf++ = (uint8)(Bits >> (8*i));
+   }
+
+   return Buf;
+
+} /* End PutDouble() */
+
+
+static uint8 *PutDoubles(uint8 *Buf, const double *Value, uint16 Cnt)
+{
+
+   uint16 i;
+
+   for (i=0; i < Cnt; i++)
+   {
+      Buf = PutDouble(Buf, Value[i]);
+   }
+
+   return Buf;
+
+} /* End PutDoubles() */
+
+
+static const uint8 *GetUint16(const uint8 *Buf, uint16 *Value)
+{
+
+   *Value = (uint16)(Buf[0] | (Buf[1] << 8));
+
+   return Buf + 2;
+
+} /* End GetUint16() */
+
+
+static const uint8 *GetUint32(const uint8 *Buf, uint32 *Value)
+{
+
+   *Value = ((uint32)Buf[0])       | ((uint32)Buf[1] << 8) |
+            ((uint32)Buf[2] << 16) | ((uint32)Buf[3] << 24);
+
+   return Buf + 4;
+
+} /* End GetUint32() */
+
+
+static const uint8 *GetDouble(const uint8 *Buf, double *Value)
+{
+
+   int    i;
+   uint64 Bits = 0;
+
+   for (i=0; i < 8; i++)
+   {
+      Bits |= ((uint64)Buf[i]) << (8*i);
+   }
+   memcpy(Value, &Bits, sizeof(Bits));
+
+   return Buf + 8;
+
+} /* End GetDouble() */
+
+
+static const uint8 *GetDoubles(const uint8 *Buf, double *Value, uint16 Cnt)
+{
+
+   uint16 i;
+
+   for (i=0; i < Cnt; i++)
+   {
+      Buf = GetDouble(Buf, &Value[i]);
+   }
+
+   return Buf;
+
+} /* End GetDoubles() */
+
+
+/******************************************************************************
+** Function: GetSensorDoubles
+**
+** Decode an enabled sensor group's doubles or zero a disabled group's. The
+** returned pointer always skips the group's bytes.
+*/
+static const uint8 *GetSensorDoubles(const uint8 *Buf, double *Value, uint16 Cnt, bool Enabled)
+{
+
+   uint16 i;
+
+   if (Enabled)
+   {
+      return GetDoubles(Buf, Value, Cnt);
+   }
+
+   for (i=0; i < Cnt; i++)
+   {
+      Value[i] = 0.0;
+   }
+
+   return Buf + (Cnt * sizeof(double));
+
+} /* End GetSensorDoubles() */
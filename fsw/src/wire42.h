@@ -0,0 +1,355 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Provide a binary framed wire protocol for the 42 socket link
+**
+**  Notes:
+**    1. 42's native socket interface exchanges line-oriented ASCII records
+**       that are formatted and parsed by BC42_LIB. This object provides an
+**       optional binary alternative that is negotiated when the socket is
+**       connected. Stock 42 doesn't answer the hello frame so the protocol
+**       is an explicit configuration choice and a link whose peer doesn't
+**       acknowledge the binary protocol is closed rather than probed.
+**    2. Every frame starts with a fixed size header followed by a fixed
+**       layout payload. All multi-byte fields are little-endian and doubles
+**       are IEEE-754 binary64.
+**
+**         Header: Sync(uint16), Version(uint8), Type(uint8),
+**                 Length(uint32, payload bytes), Seq(uint32)
+**
+**    3. The sensor frame carries exactly the AcType fields that COMM42 maps
+**       into the sensor data message. These are 42's processed sensor values
+**       so the AcApp sensor processing functions are not repeated. The
+**       actuator frame carries exactly the AcType fields that COMM42 maps
+**       from the actuator command message.
+**    4. Received bytes are pulled into a ring buffer with reads that are as
+**       large as the free space allows. Frames are parsed incrementally from
+**       the ring so a partial frame is resumed on the next read and frames
+**       that arrive together are returned without additional reads.
+**    5. An actuator batch frame carries a schedule of up to WIRE42_BATCH_MAX
+**       actuator steps preceded by the step count (uint32). 42 applies the
+**       schedule and returns the sensor frame of every step, normally with
+**       a single write, so one socket round trip covers many steps.
+**    6. Sensor fields are grouped by the sensor that provides them. Only the
+**       groups in SensorMask are decoded and the fields of the other groups
+**       are zeroed so spacecraft without a sensor don't pay for it.
+**    7. Frames are carried by the link's socket unless Shm42 is set, then
+**       the SocketId parameters are ignored and the shared memory segment
+**       is used. The framing, negotiation and parsing are the same.
+**    8. In datagram mode every socket read and write carries exactly one
+**       frame so the receive ring isn't used. A received frame whose Seq
+**       isn't newer than the last accepted frame is stale and discarded, a
+**       gap in Seq counts the lost frames. A hello exchange or a Seq that
+**       jumps more than WIRE42_RX_SEQ_RESTART backwards restarts the
+**       sequence. Actuator frames echo the Seq of the last accepted sensor
+**       frame in their header so 42 can match a command to the sensor data
+**       it responds to and recognize a resent command.
+**    9. Multiple instances can be created so the object's state is passed as
+**       a parameter rather than maintained as a file global.
+**
+*/
+#ifndef _wire42_
+#define _wire42_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "shm42.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define WIRE42_SYNC      0x42FE
+#define WIRE42_VERSION   1
+
+#define WIRE42_HDR_LEN   12
+
+#define WIRE42_FRAME_HELLO      1
+#define WIRE42_FRAME_HELLO_ACK  2
+#define WIRE42_FRAME_SENSOR     3
+#define WIRE42_FRAME_ACTUATOR   4
+#define WIRE42_FRAME_ACTUATOR_BATCH  5
+
+#define WIRE42_HELLO_PAYLOAD_LEN     8
+#define WIRE42_SENSOR_PAYLOAD_LEN  196   /* Flags(uint32) + 24 doubles */
+#define WIRE42_ACTUATOR_PAYLOAD_LEN 56   /* 7 doubles */
+
+#define WIRE42_BATCH_MAX  16   /* Actuator batch frame steps */
+#define WIRE42_ACTUATOR_BATCH_PAYLOAD_LEN(Steps)  (4 + (Steps)*WIRE42_ACTUATOR_PAYLOAD_LEN)
+
+#define WIRE42_MAX_FRAME_LEN     (WIRE42_HDR_LEN + WIRE42_SENSOR_PAYLOAD_LEN)
+#define WIRE42_MAX_TX_FRAME_LEN  (WIRE42_HDR_LEN + WIRE42_ACTUATOR_BATCH_PAYLOAD_LEN(WIRE42_BATCH_MAX))
+
+#define WIRE42_RX_RING_LEN    8192  /* Must be a power of 2 */
+#define WIRE42_RX_SEQ_RESTART 1024  /* Datagram Seq this far backwards is a peer restart, see note 8 */
+
+#define WIRE42_SENSOR_FLAG_SUN_VALID  0x00000001
+
+/*
+** Sensor groups, must agree with the EDS SensorMask definitions
+*/
+
+#define WIRE42_SENSOR_GYRO   0x0001   /* wbn  */
+#define WIRE42_SENSOR_MAG    0x0002   /* bvb  */
+#define WIRE42_SENSOR_CSS    0x0004   /* svb, SunValid */
+#define WIRE42_SENSOR_FSS    0x0008   /* svb, SunValid */
+#define WIRE42_SENSOR_ST     0x0010   /* qbn  */
+#define WIRE42_SENSOR_GPS    0x0020   /* PosN, VelN */
+#define WIRE42_SENSOR_WHL    0x0040   /* WhlH */
+#define WIRE42_SENSOR_ALL    0x007F
+
+#define WIRE42_SENSOR_SUN    (WIRE42_SENSOR_CSS | WIRE42_SENSOR_FSS)
+
+#define WIRE42_PROTOCOL_ASCII_STR   "ASCII"
+#define WIRE42_PROTOCOL_BINARY_STR  "BINARY"
+
+/*
+** Event Message IDs
+*/
+
+#define WIRE42_NEGOTIATE_EID   (WIRE42_BASE_EID + 0)
+#define WIRE42_RECV_FRAME_EID  (WIRE42_BASE_EID + 1)
+#define WIRE42_SEND_FRAME_EID  (WIRE42_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   WIRE42_PROTOCOL_ASCII  = 0,
+   WIRE42_PROTOCOL_BINARY = 1
+
+} WIRE42_Protocol_t;
+
+
+typedef enum
+{
+
+   WIRE42_RX_STATE_HEADER  = 0,   /* Searching for a valid frame header */
+   WIRE42_RX_STATE_PAYLOAD = 1    /* Header validated, waiting for payload */
+
+} WIRE42_RxState_t;
+
+
+/******************************************************************************
+** Sensor & Actuator Frames
+** - Field names match 42's AcType
+*/
+
+typedef struct
+{
+
+   double  Time;
+   double  PosN[3];
+   double  VelN[3];
+   double  qbn[4];
+   double  wbn[3];
+   double  svb[3];
+   double  bvb[3];
+   double  WhlH[4];
+   bool    SunValid;
+
+} WIRE42_SensorFrame_t;
+
+
+typedef struct
+{
+
+   double  Tcmd[3];
+   double  Mcmd[3];
+   double  SaGcmd;
+
+} WIRE42_ActuatorFrame_t;
+
+
+/******************************************************************************
+** WIRE42 Class
+*/
+
+typedef struct
+{
+
+   WIRE42_Protocol_t Protocol;   /* Protocol in use after negotiation */
+   uint16  SensorMask;           /* WIRE42_SENSOR_x groups decoded, others are zeroed */
+   SHM42_Class_t *Shm42;         /* Shared memory transport, NULL uses the socket */
+   bool    Datagram;             /* One frame per socket read and write, see note 8 */
+
+   uint32  TxSeq;
+   uint32  TxLen;           /* Length of the actuator frame in TxBuf, 0 if there isn't one */
+   uint32  TxResendCnt;
+   uint32  RxSeq;
+   bool    RxSeqValid;      /* Datagram mode, RxSeq holds an accepted frame's Seq */
+   uint32  RxFrameCnt;
+   uint32  RxFrameErrCnt;
+   uint32  RxReadCnt;       /* Socket reads used to fill the ring */
+   uint32  RxDiscardCnt;    /* Bytes skipped while resynchronizing */
+   uint32  RxStaleCnt;      /* Datagram mode, stale and out-of-order frames discarded */
+   uint32  RxLostCnt;       /* Datagram mode, frames missing from the Seq sequence */
+
+   /*
+   ** Receive ring. Head and tail are free running byte counts. 
+   */
+   
+   WIRE42_RxState_t RxState;
+   bool    RxResync;        /* Discarding bytes to find a frame header */
+   uint8   RxFrameType;     /* Valid in RX_STATE_PAYLOAD */
+   uint32  RxFrameLen;      /* Valid in RX_STATE_PAYLOAD, includes header */
+   uint32  RxHead;
+   uint32  RxTail;
+   uint8   RxRing[WIRE42_RX_RING_LEN];
+
+   uint8   RxBuf[WIRE42_MAX_FRAME_LEN];   /* Linear copy of the frame being decoded */
+   uint8   TxBuf[WIRE42_MAX_TX_FRAME_LEN];
+
+} WIRE42_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: WIRE42_Constructor
+**
+** Notes:
+**   1. The protocol defaults to ASCII until WIRE42_Negotiate() succeeds.
+**   2. The sensor mask defaults to WIRE42_SENSOR_ALL.
+**
+*/
+void WIRE42_Constructor(WIRE42_Class_t *Wire42);
+
+
+/******************************************************************************
+** Function: WIRE42_FramesQueued
+**
+** Return the number of complete frames in the receive ring that can be
+** parsed without another socket read.
+**
+*/
+uint16 WIRE42_FramesQueued(const WIRE42_Class_t *Wire42);
+
+
+/******************************************************************************
+** Function: WIRE42_Negotiate
+**
+** Send a hello frame and wait for 42 to acknowledge it.
+**
+** Notes:
+**   1. Returns true if the binary protocol has been selected. When false is
+**      returned the caller must not rely on the state of the socket stream
+**      since a non-binary peer may have sent ASCII data.
+**   2. The receive ring is flushed so this must be called once per
+**      connection before any frames are received. Datagram must be set
+**      before the call.
+**
+*/
+bool WIRE42_Negotiate(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout);
+
+
+/******************************************************************************
+** Function: WIRE42_ParseProtocol
+**
+** Convert a JSON ini protocol string to a protocol identifier. Unrecognized
+** strings default to ASCII.
+**
+*/
+WIRE42_Protocol_t WIRE42_ParseProtocol(const char *ProtocolStr);
+
+
+/******************************************************************************
+** Function: WIRE42_RecvSensorFrame
+**
+** Decode the next sensor frame. A frame already in the receive ring is
+** returned without a socket read, otherwise each socket read waits up to
+** Timeout milliseconds (OS_PEND to wait forever) for more data.
+**
+** Notes:
+**   1. Returns the frame length. OS_ERROR_TIMEOUT is returned if a complete
+**      frame wasn't received, any partial frame is kept in the receive ring.
+**      Zero or another negative value is returned if the socket closed or a
+**      read error occurred.
+**   2. Malformed data is skipped and the stream is resynchronized on the
+**      next valid frame header.
+**   3. In datagram mode malformed, stale and out-of-order datagrams are
+**      discarded and each discard restarts the Timeout wait.
+**
+*/
+int32 WIRE42_RecvSensorFrame(WIRE42_Class_t *Wire42, osal_id_t SocketId, int32 Timeout,
+                             WIRE42_SensorFrame_t *SensorFrame);
+
+
+/******************************************************************************
+** Function: WIRE42_ResendActuator
+**
+** Write the last actuator or actuator batch frame again, unchanged.
+**
+** Notes:
+**   1. Used in datagram mode when the sensor response to an actuator frame
+**      doesn't arrive. Returns false if no actuator frame has been sent since
+**      the protocol was negotiated or the write failed.
+**
+*/
+bool WIRE42_ResendActuator(WIRE42_Class_t *Wire42, osal_id_t SocketId);
+
+
+/******************************************************************************
+** Function: WIRE42_ResetStatus
+**
+*/
+void WIRE42_ResetStatus(WIRE42_Class_t *Wire42);
+
+
+/******************************************************************************
+** Function: WIRE42_Resync
+**
+** Discard the receive ring's contents, including a partially received frame,
+** and discard received bytes until the next valid frame header. Returns the
+** number of bytes discarded from the ring.
+**
+*/
+uint32 WIRE42_Resync(WIRE42_Class_t *Wire42);
+
+
+/******************************************************************************
+** Function: WIRE42_SendActuatorBatch
+**
+** Encode and write an actuator batch frame with Steps actuator frames.
+**
+** Notes:
+**   1. Steps must be between 1 and WIRE42_BATCH_MAX.
+**
+*/
+bool WIRE42_SendActuatorBatch(WIRE42_Class_t *Wire42, osal_id_t SocketId,
+                              const WIRE42_ActuatorFrame_t *ActuatorFrame, uint16 Steps);
+
+
+/******************************************************************************
+** Function: WIRE42_SendActuatorFrame
+**
+** Encode and write an actuator frame.
+**
+*/
+bool WIRE42_SendActuatorFrame(WIRE42_Class_t *Wire42, osal_id_t SocketId,
+                              const WIRE42_ActuatorFrame_t *ActuatorFrame);
+
+
+#endif /* _wire42_ */
@@ -0,0 +1,636 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host microbenchmark for the COMM42 sensor and actuator path
+**
+**  Notes:
+**    1. The flight objects are compiled unmodified against the host stubs in
+**       stubs/. Sockets are in-memory 42 peers so the results measure the
+**       interface's own processing without network or scheduling effects.
+**    2. Each benchmark reports the mean nanoseconds per operation. A cycle
+**       is one free running sensor-controller-actuator cycle for one link:
+**       actuator command processing, actuator frame write, sensor frame read
+**       and decode, and sensor data message load and send.
+**    3. BC42_LIB's AcApp processing and ASCII parser aren't part of this
+**       repo so only the binary wire protocol path is measured.
+**    4. The shared memory cycle uses a real SHM42 segment served by a 42
+**       peer thread, so it includes the doorbell wakeups and the thread
+**       handoffs in both directions.
+**    5. The UDP cycle's in-memory peer sends every datagram twice so every
+**       cycle also discards a stale duplicate.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "comm42.h"
+#include "host_stubs.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_ITERATIONS_DEF  1000000
+
+#define BENCH_SHM_NAME_LEN    32
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef void (*BENCH_Func_t)(uint32 Iterations);
+
+typedef struct
+{
+
+   const char   *Name;
+   BENCH_Func_t  Func;
+
+} BENCH_Op_t;
+
+
+/**********************/
+/** File Global Data **/
+/**********************/
+
+static COMM42_Class_t  Comm42;
+static CKPT42_Class_t  Ckpt42;
+static DELTA42_Class_t Delta42;
+static GROUP42_Class_t Group42;
+static WIRE42_Class_t  Wire42;
+static TRACE42_Class_t Trace42;
+static SHM42_Class_t   ShmPeer;
+
+static const char *RecordFile = NULL;
+static uint32     BatchSteps = 1;
+static bool       DeltaMsg   = false;
+
+/* Defeat dead code elimination of benchmark results */
+static volatile double BenchSink;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void BenchCkpt42SaveRestore(uint32 Iterations);
+static void BenchComm42Cycle(uint32 Iterations);
+static void BenchComm42CycleRecord(uint32 Iterations);
+static void BenchComm42CycleShm(uint32 Iterations);
+static void BenchComm42CycleUdp(uint32 Iterations);
+static void BenchDelta42Send(uint32 Iterations);
+static void BenchGroup42Send(uint32 Iterations);
+static void BenchTrace42Record(uint32 Iterations);
+static void BenchWire42Decode(uint32 Iterations);
+static void BenchWire42Encode(uint32 Iterations);
+static void ConfigComm42(void);
+static void RunComm42Cycles(uint32 Iterations, bool Record, COMM42_Transport_t Transport);
+static bool ShmPeerRead(uint8 *Buf, uint32 Len);
+static void *ShmPeerTask(void *Arg);
+
+static const BENCH_Op_t BenchOp[] =
+{
+   { "wire42_decode",        BenchWire42Decode      },
+   { "wire42_encode",        BenchWire42Encode      },
+   { "trace42_record",       BenchTrace42Record     },
+   { "delta42_send",         BenchDelta42Send       },
+   { "group42_send",         BenchGroup42Send       },
+   { "comm42_cycle",         BenchComm42Cycle       },
+   { "comm42_cycle_record",  BenchComm42CycleRecord },
+   { "comm42_cycle_shm",     BenchComm42CycleShm    },
+   { "comm42_cycle_udp",     BenchComm42CycleUdp    },
+   { "ckpt42_save_restore",  BenchCkpt42SaveRestore },
+   { NULL, NULL }
+};
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   int    Opt, i;
+   uint32 Iterations = BENCH_ITERATIONS_DEF;
+   const char *Filter = NULL;
+   uint64 Start, Elapsed;
+
+   while ((Opt = getopt(argc, argv, "b:dn:o:r:v")) != -1)
+   {
+      switch (Opt)
+      {
+         case 'b': BatchSteps = strtoul(optarg, NULL, 0); break;
+         case 'd': DeltaMsg = true; break;
+         case 'n': Iterations = strtoul(optarg, NULL, 0); break;
+         case 'o': Filter = optarg; break;
+         case 'r': RecordFile = optarg; break;
+         case 'v': HOST_SetVerbose(true); break;
+         default:
+            fprintf(stderr, "Usage: %s [-b batch steps] [-d] [-n iterations] [-o op] [-r record file] [-v]\n", argv[0]);
+            return 2;
+      }
+   }
+
+   if (Iterations == 0)
+   {
+      fprintf(stderr, "Iterations must be greater than zero\n");
+      return 2;
+   }
+
+   printf("%-22s %12s %12s\n", "Op", "Iterations", "ns/op");
+
+   for (i=0; BenchOp[i].Name != NULL; i++)
+   {
+
+      if ((Filter != NULL) && (strcmp(Filter, BenchOp[i].Name) != 0))
+      {
+         continue;
+      }
+      if ((BenchOp[i].Func == BenchComm42CycleRecord) && (RecordFile == NULL))
+      {
+         continue;
+      }
+
+      BenchOp[i].Func(Iterations/10 + 1);   /* Warm up */
+
+      Start = HOST_NowNsec();
+      BenchOp[i].Func(Iterations);
+      Elapsed = HOST_NowNsec() - Start;
+
+      printf("%-22s %12u %12.1f\n", BenchOp[i].Name, Iterations, (double)Elapsed/Iterations);
+
+   }
+
+   return 0;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: BenchCkpt42SaveRestore
+**
+** Save AcVar to a checkpoint file and restore it, the write includes the
+** temporary file's rename.
+*/
+static void BenchCkpt42SaveRestore(uint32 Iterations)
+{
+
+   uint32 i, RestoreCnt = 0;
+   BC42_Class_t *Bc42;
+
+   BC42_Constructor();
+   Bc42 = BC42_TakePtr();
+   CKPT42_Constructor(&Ckpt42);
+
+   for (i=0; i < Iterations; i++)
+   {
+      Bc42->AcVar.Time = i;
+      CKPT42_SaveAcVar(&Ckpt42, &Bc42->AcVar);
+      if (CKPT42_Write(&Ckpt42, "bc42_bench_ckpt.dat") && CKPT42_Read(&Ckpt42, "bc42_bench_ckpt.dat") &&
+          CKPT42_LoadAcVar(&Ckpt42, &Bc42->AcVar) && (Bc42->AcVar.Time == i))
+      {
+         ++RestoreCnt;
+      }
+   }
+   BC42_GivePtr(Bc42);
+   remove("bc42_bench_ckpt.dat");
+
+   if (RestoreCnt != Iterations)
+   {
+      fprintf(stderr, "ckpt42_save_restore: %u of %u checkpoints restored\n", RestoreCnt, Iterations);
+      exit(1);
+   }
+   BenchSink = RestoreCnt;
+
+} /* End BenchCkpt42SaveRestore() */
+
+
+/******************************************************************************
+** Function: BenchComm42Cycle
+**
+*/
+static void BenchComm42Cycle(uint32 Iterations)
+{
+
+   RunComm42Cycles(Iterations, false, COMM42_TRANSPORT_SOCKET);
+
+} /* End BenchComm42Cycle() */
+
+
+/******************************************************************************
+** Function: BenchComm42CycleRecord
+**
+*/
+static void BenchComm42CycleRecord(uint32 Iterations)
+{
+
+   RunComm42Cycles(Iterations, true, COMM42_TRANSPORT_SOCKET);
+
+} /* End BenchComm42CycleRecord() */
+
+
+/******************************************************************************
+** Function: BenchComm42CycleShm
+**
+*/
+static void BenchComm42CycleShm(uint32 Iterations)
+{
+
+   RunComm42Cycles(Iterations, false, COMM42_TRANSPORT_SHM);
+
+} /* End BenchComm42CycleShm() */
+
+
+/******************************************************************************
+** Function: BenchComm42CycleUdp
+**
+*/
+static void BenchComm42CycleUdp(uint32 Iterations)
+{
+
+   RunComm42Cycles(Iterations, false, COMM42_TRANSPORT_UDP);
+
+} /* End BenchComm42CycleUdp() */
+
+
+/******************************************************************************
+** Function: BenchDelta42Send
+**
+** Position and velocity change every message, the attitude changes every
+** other message and the remaining vectors are constant.
+*/
+static void BenchDelta42Send(uint32 Iterations)
+{
+
+   uint32 i;
+   BC42_INTF_SensorDataMsg_Payload_t SensorData;
+
+   memset(&SensorData, 0, sizeof(SensorData));
+   DELTA42_Constructor(&Delta42, true, 3, 0, 50);
+
+   for (i=0; i < Iterations; i++)
+   {
+      SensorData.GpsTime  = i;
+      SensorData.PosN[0]  = 7000.0e3 + i;
+      SensorData.VelN[1]  = 7.5e3 + 1.0e-3*i;
+      SensorData.qbn[3]   = 1.0 - 1.0e-6*(i/2);
+      DELTA42_Send(&Delta42, &SensorData);
+   }
+   BenchSink = Delta42.FieldCnt;
+
+} /* End BenchDelta42Send() */
+
+
+/******************************************************************************
+** Function: BenchGroup42Send
+**
+** The IMU group is sent every message, attitude every 2nd, wheels every 5th,
+** sun/mag every 10th and navigation every 50th.
+*/
+static void BenchGroup42Send(uint32 Iterations)
+{
+
+   static const CFE_SB_MsgId_t MsgId[GROUP42_CNT] = { 4, 5, 6, 7, 8 };
+   static const uint16 Decim[GROUP42_CNT] = { 1, 2, 50, 10, 5 };
+   uint32 i, SentCnt = 0;
+   BC42_INTF_SensorDataMsg_Payload_t SensorData;
+
+   memset(&SensorData, 0, sizeof(SensorData));
+   SensorData.SensorMask = WIRE42_SENSOR_ALL;
+   GROUP42_Constructor(&Group42, 0, MsgId, Decim);
+
+   for (i=0; i < Iterations; i++)
+   {
+      SensorData.GpsTime = i;
+      SentCnt += GROUP42_Send(&Group42, &SensorData);
+   }
+   BenchSink = SentCnt;
+
+} /* End BenchGroup42Send() */
+
+
+/******************************************************************************
+** Function: BenchTrace42Record
+**
+*/
+static void BenchTrace42Record(uint32 Iterations)
+{
+
+   uint32 i;
+
+   TRACE42_Constructor(&Trace42);
+
+   for (i=0; i < Iterations; i++)
+   {
+      TRACE42_Record(&Trace42, COMM42_TRACE_CYCLE_START, i, 0, i, i);
+   }
+
+} /* End BenchTrace42Record() */
+
+
+/******************************************************************************
+** Function: BenchWire42Decode
+**
+** Each socket read returns one sensor frame so every decode includes a ring
+** fill.
+*/
+static void BenchWire42Decode(uint32 Iterations)
+{
+
+   uint32    i;
+   osal_id_t SocketId;
+   WIRE42_SensorFrame_t SensorFrame;
+
+   WIRE42_Constructor(&Wire42);
+   OS_SocketOpen(&SocketId, OS_SocketDomain_INET, OS_SocketType_STREAM);
+
+   for (i=0; i < Iterations; i++)
+   {
+      if (WIRE42_RecvSensorFrame(&Wire42, SocketId, 0, &SensorFrame) <= 0)
+      {
+         fprintf(stderr, "wire42_decode: frame %u not decoded\n", i);
+         exit(1);
+      }
+   }
+   BenchSink = SensorFrame.Time;
+
+   OS_close(SocketId);
+
+} /* End BenchWire42Decode() */
+
+
+/******************************************************************************
+** Function: BenchWire42Encode
+**
+*/
+static void BenchWire42Encode(uint32 Iterations)
+{
+
+   uint32    i;
+   osal_id_t SocketId;
+   WIRE42_ActuatorFrame_t ActuatorFrame;
+
+   memset(&ActuatorFrame, 0, sizeof(ActuatorFrame));
+   WIRE42_Constructor(&Wire42);
+   OS_SocketOpen(&SocketId, OS_SocketDomain_INET, OS_SocketType_STREAM);
+
+   for (i=0; i < Iterations; i++)
+   {
+      ActuatorFrame.SaGcmd = i;
+      WIRE42_SendActuatorFrame(&Wire42, SocketId, &ActuatorFrame);
+   }
+
+   OS_close(SocketId);
+
+} /* End BenchWire42Encode() */
+
+
+/******************************************************************************
+** Function: ConfigComm42
+**
+** Load the ini file configuration used by COMM42_Constructor().
+*/
+static void ConfigComm42(void)
+{
+
+   HOST_SetIntConfig(CFG_APP_CMD_PIPE_ACT_MSG_LIM, 10);
+   HOST_SetIntConfig(CFG_APP_ACT_PIPE_DEPTH, 20);
+   HOST_SetIntConfig(CFG_APP_ACT_PIPE_TIMEOUT, 20);
+   HOST_SetIntConfig(CFG_EXE_UNCLOSED_CYCLE_LIM, 5);
+   HOST_SetIntConfig(CFG_EXE_SENSOR_PREFETCH, 0);
+   HOST_SetIntConfig(CFG_EXE_SIM_RATE_DEF, 0);
+   HOST_SetIntConfig(CFG_BC42_LINK_CNT, 1);
+   HOST_SetIntConfig(CFG_BC42_SOCKET_PORT, 10001);
+   HOST_SetIntConfig(CFG_BC42_CONNECT_TIMEOUT, 50);
+   HOST_SetIntConfig(CFG_BC42_CONNECT_BACKOFF_MIN, 250);
+   HOST_SetIntConfig(CFG_BC42_CONNECT_BACKOFF_MAX, 16000);
+   HOST_SetIntConfig(CFG_BC42_WIRE_HELLO_TIMEOUT, 1000);
+   HOST_SetIntConfig(CFG_BC42_CHILD_WAIT_TIMEOUT, 1000);
+   HOST_SetIntConfig(CFG_BC42_SENSOR_TIMEOUT, 1000);
+   HOST_SetIntConfig(CFG_BC42_UDP_RESEND_TIMEOUT, 100);
+   HOST_SetIntConfig(CFG_BC42_BATCH_STEPS, BatchSteps);
+   HOST_SetIntConfig(CFG_BC42_SENSOR_MASK, WIRE42_SENSOR_ALL);
+   HOST_SetIntConfig(CFG_BC42_DELTA_MSG_ENA, DeltaMsg);
+   HOST_SetIntConfig(CFG_BC42_DELTA_MSG_KEYFRAME, 50);
+   HOST_SetIntConfig(CFG_BC42_INTF_SENSOR_DATA_MSG_TOPICID, 1);
+   HOST_SetIntConfig(CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID, 2);
+   HOST_SetIntConfig(CFG_BC42_INTF_SIM_TICK_MSG_TOPICID, 3);
+   HOST_SetIntConfig(CFG_BC42_SIM_TICK_PERIOD, 1000);
+
+   HOST_SetStrConfig(CFG_BC42_WIRE_PROTOCOL, WIRE42_PROTOCOL_BINARY_STR);
+   HOST_SetStrConfig(CFG_BC42_TRANSPORT, COMM42_TRANSPORT_SOCKET_STR);
+   HOST_SetStrConfig(CFG_APP_ACT_PIPE_NAME, "BC42_INTF_ACT");
+   HOST_SetStrConfig(CFG_CHILD_SEM_NAME, "BC42_CHILD_SEM");
+   HOST_SetStrConfig(CFG_TRACE_FILE, "bc42_trace.dat");
+   HOST_SetStrConfig(CFG_RECORD_FILE, "bc42_record.dat");
+   HOST_SetStrConfig(CFG_CHECKPOINT_FILE, "bc42_ckpt.dat");
+
+} /* End ConfigComm42() */
+
+
+/******************************************************************************
+** Function: RunComm42Cycles
+**
+** Connect one binary link in free running mode and run cycles through the
+** public parent and child task entry points. The host semaphores never block
+** so each COMM42_SocketTask() call runs the child's cycle inline. The host
+** actuator pipe is always empty so actuator commands are passed directly to
+** COMM42_SendActuatorCmds() with the cycle tag of the sensor data message
+** they answer. Each iteration is one step so a batched exchange takes BatchSteps iterations,
+** except the first exchange after connecting which is one step. The shared
+** memory transport is served by ShmPeerTask().
+*/
+static void RunComm42Cycles(uint32 Iterations, bool Record, COMM42_Transport_t Transport)
+{
+
+   bool   Shm = (Transport == COMM42_TRANSPORT_SHM);
+
+   uint32 i;
+   uint32 ExpectedCycles;
+   pthread_t PeerTask;
+   char      ShmName[BENCH_SHM_NAME_LEN];
+   INITBL_Class_t IniTbl;
+   BC42_INTF_ActuatorCmdMsg_t ActuatorCmdMsg;
+   COMM42_Link_t *Link;
+
+   memset(&ActuatorCmdMsg, 0, sizeof(ActuatorCmdMsg));
+
+   ConfigComm42();
+   if (Shm)
+   {
+      snprintf(ShmName, sizeof(ShmName), "/bc42_hostbench_%d", (int)getpid());
+      SHM42_Constructor(&ShmPeer);
+      if (!SHM42_Create(&ShmPeer, ShmName) || (pthread_create(&PeerTask, NULL, ShmPeerTask, NULL) != 0))
+      {
+         fprintf(stderr, "comm42_cycle_shm: unable to serve shared memory segment %s\n", ShmName);
+         exit(1);
+      }
+      HOST_SetStrConfig(CFG_BC42_SHM_NAME, ShmName);
+   }
+   HOST_SetStrConfig(CFG_BC42_TRANSPORT, COMM42_TransportStr(Transport));
+   memset(&HostPeerStats, 0, sizeof(HostPeerStats));
+   COMM42_Constructor(&Comm42, &IniTbl);
+   COMM42_SetFreeRun(true);
+
+   if (Record && !REC42_OpenRecord(&Comm42.Rec42, RecordFile))
+   {
+      fprintf(stderr, "comm42_cycle_record: unable to open %s\n", RecordFile);
+      exit(1);
+   }
+
+   COMM42_ConnectSocket("127.0.0.1", 10001, Comm42.TransportCfg);
+   COMM42_SocketTask(NULL);
+   if (!Comm42.Link[0].SocketConnected || (Comm42.Link[0].Wire42.Protocol != WIRE42_PROTOCOL_BINARY))
+   {
+      fprintf(stderr, "comm42_cycle: binary link not connected\n");
+      exit(1);
+   }
+
+   for (i=0; i < Iterations; i++)
+   {
+      Link = &Comm42.Link[0];
+      ActuatorCmdMsg.Payload.SaGcmd     = i;
+      ActuatorCmdMsg.Payload.CycleId    = Link->CycleId - Link->ExchangeSteps + 1 + Link->ActuatorStepCnt;
+      ActuatorCmdMsg.Payload.SensorTime = Link->CycleTag[ActuatorCmdMsg.Payload.CycleId % COMM42_CYCLE_TAG_CNT].SensorTime;
+      if (!COMM42_SendActuatorCmds(0, &ActuatorCmdMsg))
+      {
+         fprintf(stderr, "comm42_cycle: actuator command for cycle %u rejected\n", ActuatorCmdMsg.Payload.CycleId);
+         exit(1);
+      }
+      COMM42_SocketTask(NULL);
+   }
+
+   ExpectedCycles = 2 + (Iterations - 1)/Comm42.BatchSteps;
+   if (Comm42.ExecuteCycleCnt != ExpectedCycles)
+   {
+      fprintf(stderr, "comm42_cycle: %u cycles executed, expected %u\n", Comm42.ExecuteCycleCnt, ExpectedCycles);
+      exit(1);
+   }
+   if ((Comm42.Link[0].Wire42.RxStaleCnt != HostPeerStats.DatagramDupCnt) || (Comm42.Link[0].Wire42.RxLostCnt != 0))
+   {
+      fprintf(stderr, "comm42_cycle_udp: %u stale and %u lost datagrams, expected %u stale\n",
+              Comm42.Link[0].Wire42.RxStaleCnt, Comm42.Link[0].Wire42.RxLostCnt, HostPeerStats.DatagramDupCnt);
+      exit(1);
+   }
+
+   if ((Comm42.Link[0].AnsweredCycleId != Iterations) || (Comm42.Link[0].CycleLostCnt != 0))
+   {
+      fprintf(stderr, "comm42_cycle: %u tagged cycles answered and %u lost, expected %u answered\n",
+              Comm42.Link[0].AnsweredCycleId, Comm42.Link[0].CycleLostCnt, Iterations);
+      exit(1);
+   }
+
+   if (!Comm42.SimTimeValid || (Comm42.SimTickMsg.Payload.TickCnt != (uint32)Comm42.SimTickIndex + 1))
+   {
+      fprintf(stderr, "comm42_cycle: %u sim ticks published by sim time %.1f\n",
+              Comm42.SimTickMsg.Payload.TickCnt, Comm42.SimTime);
+      exit(1);
+   }
+
+   COMM42_Shutdown();
+
+   if (Shm)
+   {
+      pthread_join(PeerTask, NULL);
+      SHM42_Close(&ShmPeer);
+   }
+
+} /* End RunComm42Cycles() */
+
+
+/******************************************************************************
+** Function: ShmPeerRead
+**
+** Read exactly Len bytes from the client. Returns false if the client closed.
+*/
+static bool ShmPeerRead(uint8 *Buf, uint32 Len)
+{
+
+   int32 Status;
+
+   while (Len > 0)
+   {
+      Status = SHM42_Read(&ShmPeer, Buf, Len, OS_PEND);
+      if (Status <= 0)
+      {
+         return false;
+      }
+      Buf += Status;
+      Len -= Status;
+   }
+
+   return true;
+
+} /* End ShmPeerRead() */
+
+
+/******************************************************************************
+** Function: ShmPeerTask
+**
+** Serve the shared memory segment like 42: acknowledge the hello followed by
+** the first sensor frame, then return a sensor frame for every actuator frame
+** and BatchSteps sensor frames for every actuator batch frame. Runs until
+** the client closes the segment.
+*/
+static void *ShmPeerTask(void *Arg)
+{
+
+   uint8  Buf[WIRE42_MAX_TX_FRAME_LEN];
+   uint8  SensorFrame[WIRE42_MAX_FRAME_LEN];
+   uint32 Length, Steps, i;
+   uint32 Seq = 0;
+
+   while (ShmPeerRead(Buf, WIRE42_HDR_LEN))
+   {
+
+      Length = Buf[4] | (Buf[5] << 8) | (Buf[6] << 16) | ((uint32)Buf[7] << 24);
+      if ((Length > (sizeof(Buf) - WIRE42_HDR_LEN)) || !ShmPeerRead(&Buf[WIRE42_HDR_LEN], Length))
+      {
+         break;
+      }
+
+      Steps = 1;
+      if (Buf[3] == WIRE42_FRAME_HELLO)
+      {
+         HOST_EncodeHelloAck(SensorFrame, Seq++);
+         SHM42_Write(&ShmPeer, SensorFrame, WIRE42_HDR_LEN + WIRE42_HELLO_PAYLOAD_LEN);
+      }
+      else if (Buf[3] == WIRE42_FRAME_ACTUATOR_BATCH)
+      {
+         Steps = Buf[12] | (Buf[13] << 8);
+      }
+
+      for (i=0; i < Steps; i++)
+      {
+         HOST_EncodeSensorFrame(SensorFrame, Seq, 0.1*Seq);
+         ++Seq;
+         SHM42_Write(&ShmPeer, SensorFrame, WIRE42_HDR_LEN + WIRE42_SENSOR_PAYLOAD_LEN);
+      }
+
+   } /* End while */
+
+   return NULL;
+
+} /* End ShmPeerTask() */
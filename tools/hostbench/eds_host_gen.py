@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+Generate the BC42_INTF EDS C typedef and command code headers for the host
+benchmark build. The cFS EDS toolchain generates these for the flight build;
+this covers only the EDS constructs used by eds/bc42_intf.xml.
+
+Usage: eds_host_gen.py <bc42_intf.xml> <output dir> <APP_BASE_CC>
+"""
+
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+NS = {'s': 'http://www.ccsds.org/schema/sois/seds'}
+
+BASE_TYPES = {'BASE_TYPES/uint8': 'uint8', 'BASE_TYPES/uint16': 'uint16', 'BASE_TYPES/uint32': 'uint32',
+              'BASE_TYPES/int16': 'int16', 'BASE_TYPES/int32': 'int32', 'BASE_TYPES/uint64': 'uint64',
+              'BASE_TYPES/int64': 'int64', 'BASE_TYPES/double': 'double', 'BASE_TYPES/float': 'float',
+              'APP_C_FW/BooleanUint8': 'uint8'}
+STR_TYPES  = {'APP_C_FW/IPv4Address': 16, 'BASE_TYPES/PathName': 64}
+
+
+def main(xml_file, out_dir, app_base_cc):
+    pkg = ET.parse(xml_file).getroot().find('s:Package', NS)
+    prefix = pkg.get('name')
+
+    def ctype(ref):
+        if ref in BASE_TYPES:
+            return BASE_TYPES[ref], ''
+        if ref in STR_TYPES:
+            return 'char', '[%d]' % STR_TYPES[ref]
+        if '/' in ref:
+            raise SystemExit('Unsupported EDS type ' + ref)
+        return '%s_%s_t' % (prefix, ref), ''
+
+    typedefs = ['/* Generated by eds_host_gen.py, do not edit */', '#include "cfe.h"']
+    cmd_codes = ['/* Generated by eds_host_gen.py, do not edit */']
+
+    for e in pkg.find('s:DataTypeSet', NS):
+        tag  = e.tag.split('}')[1]
+        name = e.get('name')
+        if tag == 'ArrayDataType':
+            ty, _ = ctype(e.get('dataTypeRef'))
+            dim = e.find('.//s:Dimension', NS).get('size')
+            typedefs.append('typedef %s %s_%s_t[%s];' % (ty, prefix, name, dim))
+        elif tag == 'EnumeratedDataType':
+            typedefs.append('typedef enum {')
+            for v in e.findall('.//s:Enumeration', NS):
+                typedefs.append('   %s_%s_%s = %s,' % (prefix, name, v.get('label'), v.get('value')))
+            typedefs.append('} %s_%s_Enum_t;' % (prefix, name))
+            typedefs.append('typedef uint8 %s_%s_t;' % (prefix, name))
+        elif tag == 'ContainerDataType':
+            fields = []
+            base = e.get('baseType')
+            if base == 'CFE_HDR/TelemetryHeader':
+                fields.append('CFE_MSG_TelemetryHeader_t TelemetryHeader;')
+            elif base in ('CFE_HDR/CommandHeader', 'CommandBase'):
+                fields.append('CFE_MSG_CommandHeader_t CommandHeader;')
+            elif base:
+                raise SystemExit('Unsupported EDS base type ' + base)
+            for entry in e.findall('s:EntryList/*', NS):
+                ty, dim = ctype(entry.get('type'))
+                fields.append('%s %s%s;' % (ty, entry.get('name'), dim))
+            typedefs.append('typedef struct { %s } %s_%s_t;' % (' '.join(fields), prefix, name))
+            vc = e.find('.//s:ValueConstraint', NS)
+            if vc is not None:
+                value = (vc.get('value').replace('${APP_C_FW/NOOP_CC}', '0')
+                         .replace('${APP_C_FW/RESET_CC}', '1').replace('${APP_C_FW/APP_BASE_CC}', app_base_cc))
+                cc_name = re.sub(r'Cmd$', '', name)
+                cc_name = re.sub(r'(?<=[a-z0-9])([A-Z])', r'_\1', cc_name).upper()
+                cmd_codes.append('#define %s_%s_CC (%s)' % (prefix, cc_name, value))
+        else:
+            raise SystemExit('Unsupported EDS data type ' + tag)
+
+    os.makedirs(out_dir, exist_ok=True)
+    base_name = prefix.lower()
+    with open(os.path.join(out_dir, base_name + '_eds_typedefs.h'), 'w') as f:
+        f.write('\n'.join(typedefs) + '\n')
+    with open(os.path.join(out_dir, base_name + '_eds_cc.h'), 'w') as f:
+        f.write('\n'.join(cmd_codes) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 4:
+        raise SystemExit(__doc__)
+    main(*sys.argv[1:])
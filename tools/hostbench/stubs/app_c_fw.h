@@ -0,0 +1,32 @@
+/*
+** Host build stand-ins for the app_c_fw declarations used by the BC42_INTF
+** objects. INITBL values are set by the benchmark, see host_stubs.h.
+*/
+#ifndef _hostbench_app_c_fw_
+#define _hostbench_app_c_fw_
+#include "cfe.h"
+#define APP_C_FW_APP_BASE_EID 100
+#define APP_C_FW_CFS_ERROR (-1)
+typedef struct { uint32 x; } INITBL_Class_t;
+typedef struct { const char *Str; } INILIB_CfgEnum_t;
+#define DECLARE_ENUM(n, X) enum { X(ENUM_ID) n##_MAX };
+#define ENUM_ID(a,b) a,
+#define DEFINE_ENUM(n, X) static INILIB_CfgEnum_t IniCfgEnum = { #n };
+bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile, INILIB_CfgEnum_t *CfgEnum);
+uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+const char *INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+typedef bool (*CMDMGR_CmdFuncPtr)(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+typedef struct { uint16 ValidCmdCnt; uint16 InvalidCmdCnt; } CMDMGR_Class_t;
+void CMDMGR_Constructor(CMDMGR_Class_t *CmdMgr);
+bool CMDMGR_RegisterFunc(CMDMGR_Class_t *CmdMgr, uint16 FuncCode, void *ObjDataPtr, CMDMGR_CmdFuncPtr ObjFuncPtr, uint16 UserDataLen);
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t *CmdMgr, const CFE_MSG_Message_t *MsgPtr);
+void CMDMGR_ResetStatus(CMDMGR_Class_t *CmdMgr);
+#define CMDMGR_PAYLOAD_PTR(msg_ptr, cmd_type) &(((const cmd_type *)(msg_ptr))->Payload)
+typedef struct CHILDMGR_Class CHILDMGR_Class_t;
+typedef bool (*CHILDMGR_TaskCallback_t)(CHILDMGR_Class_t *ChildMgr);
+struct CHILDMGR_Class { uint32 x; };
+typedef struct { const char *TaskName; uint32 StackSize; uint32 Priority; uint32 PerfId; } CHILDMGR_TaskInit_t;
+void ChildMgr_TaskMainCallback(void);
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t *ChildMgr, void (*ChildTaskMainFunc)(void), CHILDMGR_TaskCallback_t AppMainFunc, CHILDMGR_TaskInit_t *TaskInit);
+void CHILDMGR_ResetStatus(CHILDMGR_Class_t *ChildMgr);
+#endif
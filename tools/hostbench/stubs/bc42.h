@@ -0,0 +1,27 @@
+/*
+** Host build stand-in for BC42_LIB. AcType only has the fields COMM42 uses
+** and the AcApp processing functions are empty.
+*/
+#ifndef _hostbench_bc42_
+#define _hostbench_bc42_
+#include "cfe.h"
+typedef int SOCKET;
+struct AcWhlType { double H; double Tcmd; };
+struct AcMtbType { double Mcmd; };
+struct AcGCmdType { double Ang[3]; };
+struct AcGType { struct AcGCmdType Cmd; };
+struct AcType {
+   long EchoEnabled; long Nwhl; long Nmtb; double Time; double DT;
+   double PosN[3]; double VelN[3]; double qbn[4]; double wbn[3]; double svb[3]; double bvb[3];
+   long SunValid; double Tcmd[3]; double Mcmd[3];
+   struct AcWhlType *Whl; struct AcMtbType *MTB; struct AcGType *G;
+};
+typedef struct { struct AcType AcVar; } BC42_Class_t;
+void BC42_Constructor(void);
+BC42_Class_t *BC42_TakePtr(void); void BC42_GivePtr(BC42_Class_t *Bc42Ptr);
+int BC42_ReadFromSocket(osal_id_t SocketId, OS_SockAddr_t *SocketAddr, struct AcType *AC);
+void BC42_WriteToSocket(osal_id_t SocketId, OS_SockAddr_t *SocketAddr, struct AcType *AC);
+void GyroProcessing(struct AcType *AC); void MagnetometerProcessing(struct AcType *AC); void CssProcessing(struct AcType *AC);
+void FssProcessing(struct AcType *AC); void StarTrackerProcessing(struct AcType *AC); void GpsProcessing(struct AcType *AC);
+void WheelProcessing(struct AcType *AC); void MtbProcessing(struct AcType *AC);
+#endif
@@ -0,0 +1,124 @@
+/*
+** Host build stand-ins for the cFE, OSAL and PSP declarations used by the
+** BC42_INTF objects. Only what the objects use is declared. The definitions
+** are in host_stubs.c.
+*/
+#ifndef _hostbench_cfe_
+#define _hostbench_cfe_
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+typedef uint8_t uint8; typedef uint16_t uint16; typedef uint32_t uint32; typedef uint64_t uint64;
+typedef int8_t int8; typedef int16_t int16; typedef int32_t int32; typedef int64_t int64;
+typedef uint32 osal_id_t;
+#define OS_OBJECT_ID_UNDEFINED 0
+#define OS_MAX_PATH_LEN 64
+typedef struct { int64 ticks; } OS_time_t;
+typedef struct { uint32 ActualLength; union { uint8 Buffer[28]; uint32 align; } AddrData; } OS_SockAddr_t;
+typedef enum { OS_SocketDomain_INVALID, OS_SocketDomain_INET, OS_SocketDomain_INET6 } OS_SocketDomain_t;
+typedef enum { OS_SocketType_INVALID, OS_SocketType_DATAGRAM, OS_SocketType_STREAM } OS_SocketType_t;
+typedef struct { uint8 object_ids[128]; } OS_FdSet;
+#define OS_SUCCESS 0
+#define OS_ERROR (-1)
+#define OS_ERROR_TIMEOUT (-34)
+#define OS_SEM_TIMEOUT (-7)
+#define OS_QUEUE_FULL (-9)
+#define OS_SEM_EMPTY 0
+#define OS_STREAM_STATE_READABLE 1
+#define OS_STREAM_STATE_WRITABLE 2
+#define OS_FILE_FLAG_NONE 0
+#define OS_FILE_FLAG_CREATE 1
+#define OS_FILE_FLAG_TRUNCATE 2
+#define OS_READ_ONLY 0
+#define OS_WRITE_ONLY 1
+#define OS_READ_WRITE 2
+#define OS_PEND (-1)
+#define OS_CHECK (0)
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options);
+int32 OS_BinSemGive(osal_id_t); int32 OS_BinSemTake(osal_id_t); int32 OS_BinSemTimedWait(osal_id_t, uint32);
+int32 OS_BinSemDelete(osal_id_t);
+int32 OS_SocketOpen(osal_id_t *sock_id, OS_SocketDomain_t Domain, OS_SocketType_t Type);
+int32 OS_SocketConnect(osal_id_t sock_id, const OS_SockAddr_t *Addr, int32 timeout);
+int32 OS_SocketBind(osal_id_t sock_id, const OS_SockAddr_t *Addr);
+int32 OS_SocketAddrInit(OS_SockAddr_t *Addr, OS_SocketDomain_t Domain);
+int32 OS_SocketAddrFromString(OS_SockAddr_t *Addr, const char *string);
+int32 OS_SocketAddrToString(char *buffer, size_t buflen, const OS_SockAddr_t *Addr);
+int32 OS_SocketAddrSetPort(OS_SockAddr_t *Addr, uint16 PortNum);
+int32 OS_SocketRecvFrom(osal_id_t sock_id, void *buffer, size_t buflen, OS_SockAddr_t *RemoteAddr, int32 timeout);
+int32 OS_SocketSendTo(osal_id_t sock_id, const void *buffer, size_t buflen, const OS_SockAddr_t *RemoteAddr);
+int32 OS_read(osal_id_t, void *, size_t); int32 OS_write(osal_id_t, const void *, size_t);
+int32 OS_TimedRead(osal_id_t, void *, size_t, int32); int32 OS_TimedWrite(osal_id_t, const void *, size_t, int32);
+int32 OS_close(osal_id_t);
+int32 OS_lseek(osal_id_t, int32, uint32);
+#define OS_SEEK_SET 0
+#define OS_SEEK_CUR 1
+#define OS_SEEK_END 2
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode);
+int32 OS_remove(const char *path); int32 OS_rename(const char *old_filename, const char *new_filename);
+int32 OS_SelectMultiple(OS_FdSet *ReadSet, OS_FdSet *WriteSet, int32 msecs);
+int32 OS_SelectSingle(osal_id_t objid, uint32 *StateFlags, int32 msecs);
+int32 OS_SelectFdZero(OS_FdSet *Set); int32 OS_SelectFdAdd(OS_FdSet *Set, osal_id_t objid); bool OS_SelectFdIsSet(const OS_FdSet *Set, osal_id_t objid);
+int32 OS_TaskDelay(uint32 millisecond);
+int32 OS_GetLocalTime(OS_time_t *time_struct);
+int32 OS_TaskInstallDeleteHandler(void (*function_pointer)(void));
+OS_time_t OS_TimeSubtract(OS_time_t, OS_time_t); OS_time_t OS_TimeAdd(OS_time_t, OS_time_t);
+int64 OS_TimeGetTotalMicroseconds(OS_time_t); int64 OS_TimeGetTotalMilliseconds(OS_time_t);
+int64 OS_TimeGetTotalNanoseconds(OS_time_t);
+OS_time_t OS_TimeFromTotalMilliseconds(int64); OS_time_t OS_TimeFromTotalMicroseconds(int64);
+bool OS_ObjectIdDefined(osal_id_t);
+/* cFE */
+typedef struct { uint32 Value; } CFE_SB_MsgId_Atom_t; typedef uint32 CFE_SB_MsgId_t; typedef uint32 CFE_SB_PipeId_t;
+typedef struct { uint8 Byte[8]; } CFE_MSG_Message_t;
+typedef union { CFE_MSG_Message_t Msg; uint64 align; } CFE_SB_Buffer_t;
+typedef struct { CFE_MSG_Message_t Msg; uint8 Sec[6]; uint8 Spare[4]; } CFE_MSG_TelemetryHeader_t;
+typedef struct { CFE_MSG_Message_t Msg; uint8 Sec[2]; } CFE_MSG_CommandHeader_t;
+typedef size_t CFE_MSG_Size_t;
+typedef struct { uint8 Priority; uint8 Reliability; } CFE_SB_Qos_t;
+typedef struct { uint16 EventID; uint16 Mask; } CFE_EVS_BinFilter_t;
+typedef uint32 CFE_ES_AppId_t;
+typedef struct { uint32 NumOfChildTasks; } CFE_ES_AppInfo_t;
+typedef struct { uint32 Seconds; uint32 Subseconds; } CFE_TIME_SysTime_t;
+#define CFE_SUCCESS 0
+#define CFE_SB_INVALID_MSG_ID 0
+#define CFE_SB_PEND_FOREVER (-1)
+#define CFE_SB_POLL 0
+#define CFE_SB_NO_MESSAGE ((int32)0xca00000e)
+#define CFE_SB_TIME_OUT ((int32)0xca000001)
+#define CFE_SB_INVALID_PIPE 0
+#define CFE_MSG_PTR(shared_hdr) (&((shared_hdr).Msg))
+#define CFE_EVS_FIRST_64_STOP 0xFFC0
+#define CFE_EVS_FIRST_ONE_STOP 0xFFFF
+#define CFE_EVS_NO_FILTER 0
+#define CFE_EVS_EventFilter_BINARY 0
+#define CFE_EVS_DEBUG 1
+#define CFE_EVS_INFORMATION 2
+enum { CFE_EVS_EventType_DEBUG = 1, CFE_EVS_EventType_INFORMATION, CFE_EVS_EventType_ERROR, CFE_EVS_EventType_CRITICAL };
+enum { CFE_ES_RunStatus_UNDEFINED, CFE_ES_RunStatus_APP_RUN, CFE_ES_RunStatus_APP_EXIT, CFE_ES_RunStatus_APP_ERROR };
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...) __attribute__((format(printf,3,4)));
+int32 CFE_EVS_Register(const void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme);
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...) __attribute__((format(printf,1,2)));
+bool CFE_ES_RunLoop(uint32 *RunStatus); void CFE_ES_ExitApp(uint32 ExitStatus);
+void CFE_ES_PerfLogEntry(uint32); void CFE_ES_PerfLogExit(uint32);
+int32 CFE_ES_GetAppID(CFE_ES_AppId_t *AppIdPtr); int32 CFE_ES_GetAppInfo(CFE_ES_AppInfo_t *AppInfo, CFE_ES_AppId_t AppId);
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+int32 CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32); uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t); bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t, CFE_SB_MsgId_t);
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_SubscribeEx(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, CFE_SB_Qos_t Quality, uint16 MsgLim);
+int32 CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId);
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+void CFE_PSP_GetTime(OS_time_t *LocalTime);
+int32 CFE_PSP_MemSet(void *dst, uint8 value, uint32 size);
+int32 CFE_PSP_MemCpy(void *dst, const void *src, uint32 size);
+typedef struct { uint32 ContentType; uint32 SubType; uint32 Length; char Description[32]; } CFE_FS_Header_t;
+void CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType);
+int32 CFE_FS_WriteHeader(osal_id_t FileDes, CFE_FS_Header_t *Hdr);
+int32 CFE_FS_ReadHeader(CFE_FS_Header_t *Hdr, osal_id_t FileDes);
+#define CFE_FS_SubType_USER_BASE 0x100
+#endif
@@ -0,0 +1,367 @@
+/*
+** Host build definitions for the cFE, OSAL, PSP, app_c_fw and BC42_LIB
+** services used by the BC42_INTF objects. See host_stubs.h.
+*/
+
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bc42.h"
+#include "host_stubs.h"
+#include "wire42.h"
+
+#define HOST_SOCKET_ID_BASE  0x10000   /* Socket ids, file ids are host fds plus one */
+#define HOST_SOCKET_MAX      8
+
+#define HOST_TICKS_PER_USEC  10        /* OSAL OS_time_t ticks are 100ns */
+
+HOST_PeerStats_t HostPeerStats;
+
+static uint32     HostIntCfg[Config_MAX];
+static const char *HostStrCfg[Config_MAX];
+static bool       HostVerbose = false;
+
+typedef struct
+{
+
+   bool    Open;
+   bool    Datagram;
+   bool    Dup;         /* Datagram socket, the frame in TxBuf has been read twice */
+   uint32  TxSeq;
+   uint32  TxLen;       /* Frame bytes waiting to be read */
+   uint32  TxOffset;
+   uint8   TxBuf[WIRE42_MAX_FRAME_LEN];
+
+} HOST_Socket_t;
+
+static HOST_Socket_t HostSocket[HOST_SOCKET_MAX];
+
+static BC42_Class_t      Bc42;
+static struct AcWhlType  AcWhl[4];
+static struct AcMtbType  AcMtb[3];
+static struct AcGType    AcG[1];
+
+
+/*
+** Benchmark Controls
+*/
+
+void HOST_SetIntConfig(uint16 Param, uint32 Value) { HostIntCfg[Param] = Value; }
+void HOST_SetStrConfig(uint16 Param, const char *Value) { HostStrCfg[Param] = Value; }
+void HOST_SetVerbose(bool Verbose) { HostVerbose = Verbose; }
+
+uint64 HOST_NowNsec(void)
+{
+   struct timespec Ts;
+   clock_gettime(CLOCK_MONOTONIC, &Ts);
+   return (uint64)Ts.tv_sec*1000000000ULL + (uint64)Ts.tv_nsec;
+}
+
+static uint8 *PutLe(uint8 *Buf, uint64 Value, int Len)
+{
+   int i;
+   for (i=0; i < Len; i++)
+   {
+      Buf[i] = (uint8)(Value >> (8*i));
+   }
+   return Buf + Len;
+}
+
+static uint8 *PutLeDouble(uint8 *Buf, double Value)
+{
+   uint64 Bits;
+   memcpy(&Bits, &Value, sizeof(Bits));
+   return PutLe(Buf, Bits, 8);
+}
+
+static uint8 *PutFrameHdr(uint8 *Buf, uint8 Type, uint32 Length, uint32 Seq)
+{
+   Buf = PutLe(Buf, WIRE42_SYNC, 2);
+   *Buf++ = WIRE42_VERSION;
+   *Buf++ = Type;
+   Buf = PutLe(Buf, Length, 4);
+   return PutLe(Buf, Seq, 4);
+}
+
+void HOST_EncodeSensorFrame(uint8 *Buf, uint32 Seq, double Time)
+{
+   int i;
+   Buf = PutFrameHdr(Buf, WIRE42_FRAME_SENSOR, WIRE42_SENSOR_PAYLOAD_LEN, Seq);
+   Buf = PutLe(Buf, WIRE42_SENSOR_FLAG_SUN_VALID, 4);
+   Buf = PutLeDouble(Buf, Time);
+   for (i=0; i < 23; i++)
+   {
+      Buf = PutLeDouble(Buf, Time + 0.001*i);
+   }
+}
+
+void HOST_EncodeHelloAck(uint8 *Buf, uint32 Seq)
+{
+   Buf = PutFrameHdr(Buf, WIRE42_FRAME_HELLO_ACK, WIRE42_HELLO_PAYLOAD_LEN, Seq);
+   Buf = PutLe(Buf, WIRE42_SENSOR_PAYLOAD_LEN, 4);
+   PutLe(Buf, WIRE42_ACTUATOR_PAYLOAD_LEN, 4);
+}
+
+static HOST_Socket_t *GetSocket(osal_id_t Id)
+{
+   if ((Id >= HOST_SOCKET_ID_BASE) && (Id < HOST_SOCKET_ID_BASE + HOST_SOCKET_MAX))
+   {
+      return &HostSocket[Id - HOST_SOCKET_ID_BASE];
+   }
+   return NULL;
+}
+
+
+/*
+** OSAL
+*/
+
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options) { *sem_id = 1; return OS_SUCCESS; }
+int32 OS_BinSemGive(osal_id_t Id) { return OS_SUCCESS; }
+int32 OS_BinSemTake(osal_id_t Id) { return OS_SUCCESS; }
+int32 OS_BinSemTimedWait(osal_id_t Id, uint32 Msecs) { return OS_SUCCESS; }
+int32 OS_BinSemDelete(osal_id_t Id) { return OS_SUCCESS; }
+
+int32 OS_SocketOpen(osal_id_t *sock_id, OS_SocketDomain_t Domain, OS_SocketType_t Type)
+{
+   int i;
+   for (i=0; i < HOST_SOCKET_MAX; i++)
+   {
+      if (!HostSocket[i].Open)
+      {
+         memset(&HostSocket[i], 0, sizeof(HOST_Socket_t));
+         HostSocket[i].Open = true;
+         HostSocket[i].Datagram = (Type == OS_SocketType_DATAGRAM);
+         *sock_id = HOST_SOCKET_ID_BASE + i;
+         return OS_SUCCESS;
+      }
+   }
+   return OS_ERROR;
+}
+
+int32 OS_SocketConnect(osal_id_t sock_id, const OS_SockAddr_t *Addr, int32 timeout) { return OS_SUCCESS; }
+int32 OS_SocketBind(osal_id_t sock_id, const OS_SockAddr_t *Addr) { return OS_SUCCESS; }
+int32 OS_SocketAddrInit(OS_SockAddr_t *Addr, OS_SocketDomain_t Domain) { memset(Addr, 0, sizeof(*Addr)); return OS_SUCCESS; }
+int32 OS_SocketAddrFromString(OS_SockAddr_t *Addr, const char *string) { return OS_SUCCESS; }
+int32 OS_SocketAddrToString(char *buffer, size_t buflen, const OS_SockAddr_t *Addr) { snprintf(buffer, buflen, "mem"); return OS_SUCCESS; }
+int32 OS_SocketAddrSetPort(OS_SockAddr_t *Addr, uint16 PortNum) { return OS_SUCCESS; }
+int32 OS_SocketRecvFrom(osal_id_t sock_id, void *buffer, size_t buflen, OS_SockAddr_t *RemoteAddr, int32 timeout) { return OS_ERROR_TIMEOUT; }
+int32 OS_SocketSendTo(osal_id_t sock_id, const void *buffer, size_t buflen, const OS_SockAddr_t *RemoteAddr) { return (int32)buflen; }
+
+/* A hello is answered with an acknowledge, otherwise the peer sends one sensor frame per read. Datagrams are duplicated. */
+int32 OS_TimedRead(osal_id_t Id, void *Buffer, size_t Len, int32 Timeout)
+{
+   HOST_Socket_t *Socket = GetSocket(Id);
+
+   if (Socket == NULL)
+   {
+      return OS_read(Id, Buffer, Len);
+   }
+   if ((Socket->TxOffset == Socket->TxLen) && Socket->Datagram && !Socket->Dup && (Socket->TxLen > 0))
+   {
+      Socket->Dup      = true;
+      Socket->TxOffset = 0;
+      ++HostPeerStats.DatagramDupCnt;
+   }
+   else if (Socket->TxOffset == Socket->TxLen)
+   {
+      Socket->Dup = false;
+      HOST_EncodeSensorFrame(Socket->TxBuf, Socket->TxSeq, 0.1*Socket->TxSeq);
+      ++Socket->TxSeq;
+      ++HostPeerStats.SensorFrameCnt;
+      Socket->TxLen    = WIRE42_HDR_LEN + WIRE42_SENSOR_PAYLOAD_LEN;
+      Socket->TxOffset = 0;
+   }
+   if (Len > Socket->TxLen - Socket->TxOffset)
+   {
+      Len = Socket->TxLen - Socket->TxOffset;
+   }
+   memcpy(Buffer, &Socket->TxBuf[Socket->TxOffset], Len);
+   Socket->TxOffset += Len;
+   return (int32)Len;
+}
+
+int32 OS_TimedWrite(osal_id_t Id, const void *Buffer, size_t Len, int32 Timeout)
+{
+   HOST_Socket_t *Socket = GetSocket(Id);
+   const uint8 *Buf = Buffer;
+
+   if (Socket == NULL)
+   {
+      return OS_write(Id, Buffer, Len);
+   }
+   if ((Len >= WIRE42_HDR_LEN) && (Buf[3] == WIRE42_FRAME_HELLO))
+   {
+      HOST_EncodeHelloAck(Socket->TxBuf, Socket->TxSeq++);
+      Socket->TxLen    = WIRE42_HDR_LEN + WIRE42_HELLO_PAYLOAD_LEN;
+      Socket->TxOffset = 0;
+      ++HostPeerStats.HelloCnt;
+   }
+   else
+   {
+      ++HostPeerStats.WriteCnt;
+      HostPeerStats.WriteBytes += Len;
+   }
+   return (int32)Len;
+}
+
+int32 OS_read(osal_id_t Id, void *Buffer, size_t Len)
+{
+   return GetSocket(Id) ? OS_TimedRead(Id, Buffer, Len, OS_PEND) : (int32)read((int)Id - 1, Buffer, Len);
+}
+
+int32 OS_write(osal_id_t Id, const void *Buffer, size_t Len)
+{
+   return GetSocket(Id) ? OS_TimedWrite(Id, Buffer, Len, OS_PEND) : (int32)write((int)Id - 1, Buffer, Len);
+}
+
+int32 OS_close(osal_id_t Id)
+{
+   HOST_Socket_t *Socket = GetSocket(Id);
+   if (Socket != NULL)
+   {
+      Socket->Open = false;
+      return OS_SUCCESS;
+   }
+   return (close((int)Id - 1) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_lseek(osal_id_t Id, int32 Offset, uint32 Whence)
+{
+   return (int32)lseek((int)Id - 1, Offset, (Whence == OS_SEEK_SET) ? SEEK_SET : ((Whence == OS_SEEK_CUR) ? SEEK_CUR : SEEK_END));
+}
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode)
+{
+   int Flags = (access_mode == OS_READ_ONLY) ? O_RDONLY : ((access_mode == OS_WRITE_ONLY) ? O_WRONLY : O_RDWR);
+   int Fd;
+   if (flags & OS_FILE_FLAG_CREATE)   Flags |= O_CREAT;
+   if (flags & OS_FILE_FLAG_TRUNCATE) Flags |= O_TRUNC;
+   Fd = open(path, Flags, 0644);
+   if (Fd < 0)
+   {
+      return OS_ERROR;
+   }
+   *filedes = (osal_id_t)Fd + 1;
+   return OS_SUCCESS;
+}
+
+int32 OS_remove(const char *path) { return (unlink(path) == 0) ? OS_SUCCESS : OS_ERROR; }
+int32 OS_rename(const char *old_filename, const char *new_filename) { return (rename(old_filename, new_filename) == 0) ? OS_SUCCESS : OS_ERROR; }
+
+/* In-memory sockets are always readable */
+int32 OS_SelectMultiple(OS_FdSet *ReadSet, OS_FdSet *WriteSet, int32 msecs) { return OS_SUCCESS; }
+int32 OS_SelectSingle(osal_id_t objid, uint32 *StateFlags, int32 msecs) { return OS_SUCCESS; }
+int32 OS_SelectFdZero(OS_FdSet *Set) { memset(Set, 0, sizeof(*Set)); return OS_SUCCESS; }
+int32 OS_SelectFdAdd(OS_FdSet *Set, osal_id_t Id) { Set->object_ids[0] |= (1 << (Id % HOST_SOCKET_MAX)); return OS_SUCCESS; }
+bool  OS_SelectFdIsSet(const OS_FdSet *Set, osal_id_t Id) { return (Set->object_ids[0] & (1 << (Id % HOST_SOCKET_MAX))) != 0; }
+
+int32 OS_TaskDelay(uint32 millisecond) { usleep(1000*millisecond); return OS_SUCCESS; }
+int32 OS_TaskInstallDeleteHandler(void (*function_pointer)(void)) { return OS_SUCCESS; }
+
+int32 OS_GetLocalTime(OS_time_t *time_struct) { CFE_PSP_GetTime(time_struct); return OS_SUCCESS; }
+
+OS_time_t OS_TimeSubtract(OS_time_t A, OS_time_t B) { OS_time_t T = { A.ticks - B.ticks }; return T; }
+OS_time_t OS_TimeAdd(OS_time_t A, OS_time_t B) { OS_time_t T = { A.ticks + B.ticks }; return T; }
+int64 OS_TimeGetTotalMicroseconds(OS_time_t T) { return T.ticks / HOST_TICKS_PER_USEC; }
+int64 OS_TimeGetTotalMilliseconds(OS_time_t T) { return T.ticks / (1000*HOST_TICKS_PER_USEC); }
+int64 OS_TimeGetTotalNanoseconds(OS_time_t T) { return T.ticks * (1000/HOST_TICKS_PER_USEC); }
+OS_time_t OS_TimeFromTotalMilliseconds(int64 Msec) { OS_time_t T = { Msec*1000*HOST_TICKS_PER_USEC }; return T; }
+OS_time_t OS_TimeFromTotalMicroseconds(int64 Usec) { OS_time_t T = { Usec*HOST_TICKS_PER_USEC }; return T; }
+bool OS_ObjectIdDefined(osal_id_t Id) { return Id != OS_OBJECT_ID_UNDEFINED; }
+
+
+/*
+** cFE and PSP
+*/
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+   va_list Args;
+   ++HostPeerStats.EventCnt;
+   if (HostVerbose)
+   {
+      va_start(Args, Spec);
+      printf("EVS %3d: ", EventID);
+      vprintf(Spec, Args);
+      printf("\n");
+      va_end(Args);
+   }
+   return CFE_SUCCESS;
+}
+
+int32 CFE_EVS_Register(const void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme) { return CFE_SUCCESS; }
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...) { return CFE_SUCCESS; }
+void CFE_ES_PerfLogEntry(uint32 Id) { }
+void CFE_ES_PerfLogExit(uint32 Id) { }
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size) { memset(MsgPtr, 0, Size); return CFE_SUCCESS; }
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId) { *MsgId = 0; return CFE_SUCCESS; }
+int32 CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size) { return CFE_SUCCESS; }
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size) { *Size = 0; return CFE_SUCCESS; }
+
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 Value) { return Value; }
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t MsgId) { return MsgId; }
+bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t A, CFE_SB_MsgId_t B) { return A == B; }
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr) { }
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount) { return CFE_SUCCESS; }
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName) { *PipeIdPtr = 1; return CFE_SUCCESS; }
+int32 CFE_SB_SubscribeEx(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, CFE_SB_Qos_t Quality, uint16 MsgLim) { return CFE_SUCCESS; }
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut) { return (TimeOut == CFE_SB_POLL) ? CFE_SB_NO_MESSAGE : CFE_SB_TIME_OUT; }
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void) { CFE_TIME_SysTime_t T = { 0, 0 }; return T; }
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime) { LocalTime->ticks = (int64)(HOST_NowNsec() / (1000/HOST_TICKS_PER_USEC)); }
+int32 CFE_PSP_MemSet(void *dst, uint8 value, uint32 size) { memset(dst, value, size); return CFE_SUCCESS; }
+int32 CFE_PSP_MemCpy(void *dst, const void *src, uint32 size) { memcpy(dst, src, size); return CFE_SUCCESS; }
+
+void CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType)
+{
+   memset(Hdr, 0, sizeof(*Hdr));
+   strncpy(Hdr->Description, Description, sizeof(Hdr->Description)-1);
+   Hdr->SubType = SubType;
+}
+
+int32 CFE_FS_WriteHeader(osal_id_t FileDes, CFE_FS_Header_t *Hdr) { return OS_write(FileDes, Hdr, sizeof(*Hdr)); }
+int32 CFE_FS_ReadHeader(CFE_FS_Header_t *Hdr, osal_id_t FileDes) { return OS_read(FileDes, Hdr, sizeof(*Hdr)); }
+
+
+/*
+** app_c_fw
+*/
+
+uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param) { return HostIntCfg[Param]; }
+const char *INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param) { return HostStrCfg[Param] ? HostStrCfg[Param] : ""; }
+
+
+/*
+** BC42_LIB, the AcApp processing functions aren't part of this repo
+*/
+
+void BC42_Constructor(void)
+{
+   memset(&Bc42, 0, sizeof(Bc42));
+   Bc42.AcVar.Nwhl = 4;
+   Bc42.AcVar.Nmtb = 3;
+   Bc42.AcVar.Whl  = AcWhl;
+   Bc42.AcVar.MTB  = AcMtb;
+   Bc42.AcVar.G    = AcG;
+}
+
+BC42_Class_t *BC42_TakePtr(void) { return &Bc42; }
+void BC42_GivePtr(BC42_Class_t *Bc42Ptr) { }
+int  BC42_ReadFromSocket(osal_id_t SocketId, OS_SockAddr_t *SocketAddr, struct AcType *AC) { return 0; }
+void BC42_WriteToSocket(osal_id_t SocketId, OS_SockAddr_t *SocketAddr, struct AcType *AC) { }
+void GyroProcessing(struct AcType *AC) { }
+void MagnetometerProcessing(struct AcType *AC) { }
+void CssProcessing(struct AcType *AC) { }
+void FssProcessing(struct AcType *AC) { }
+void StarTrackerProcessing(struct AcType *AC) { }
+void GpsProcessing(struct AcType *AC) { }
+void WheelProcessing(struct AcType *AC) { }
+void MtbProcessing(struct AcType *AC) { }
@@ -0,0 +1,36 @@
+/*
+** Host benchmark controls for the stubbed cFE, OSAL and INITBL services.
+**
+** Sockets are in-memory 42 peers that never block. A binary hello is
+** answered with an acknowledge and otherwise each read returns the next
+** little-endian sensor frame, split when the read is smaller than the
+** frame. A datagram socket returns every frame twice. Files are real host
+** files.
+*/
+#ifndef _hostbench_host_stubs_
+#define _hostbench_host_stubs_
+
+#include "app_cfg.h"
+
+typedef struct
+{
+
+   uint32  HelloCnt;
+   uint32  SensorFrameCnt;   /* Sensor frames returned by socket reads */
+   uint32  WriteCnt;         /* Socket writes other than hellos */
+   uint64  WriteBytes;
+   uint32  EventCnt;
+   uint32  DatagramDupCnt;   /* Duplicate datagrams returned by datagram socket reads */
+
+} HOST_PeerStats_t;
+
+extern HOST_PeerStats_t HostPeerStats;
+
+void   HOST_SetIntConfig(uint16 Param, uint32 Value);
+void   HOST_SetStrConfig(uint16 Param, const char *Value);
+void   HOST_SetVerbose(bool Verbose);
+void   HOST_EncodeHelloAck(uint8 *Buf, uint32 Seq);
+void   HOST_EncodeSensorFrame(uint8 *Buf, uint32 Seq, double Time);
+uint64 HOST_NowNsec(void);
+
+#endif /* _hostbench_host_stubs_ */
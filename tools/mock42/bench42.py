@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""
+End-to-end BC42_INTF throughput benchmark.
+
+Starts the mock42 stand-in 42 endpoint, commands a running BC42_INTF app to
+connect to it, and sweeps the app's execution configuration. For each sweep
+point the sustained steps/sec and the closed-loop latency percentiles are
+measured at the mock 42 side of the socket so no app telemetry decoding is
+needed.
+
+Commands are sent to the cFS command ingest UDP port as EDS packed (big
+endian) CCSDS command packets. The command message ID and the app's base
+command function code depend on the mission configuration so they are
+arguments. Without --cmd-mid no commands are sent and the app must be
+connected and configured by other means.
+
+Exit status is 1 if any sweep point's rate is below --min-rate so the
+benchmark can gate a CI job.
+
+Usage: bench42.py --cmd-mid 0x1FD0 [--cycles 1,5,10] [--delays 10,50] [--free-run]
+"""
+
+import argparse
+import json
+import socket
+import struct
+import sys
+import time
+
+import mock42
+
+# BC42_INTF command function code offsets from APP_C_FW's APP_BASE_CC, must agree with eds/bc42_intf.xml
+
+CONFIG_EXECUTE_CC_OFFSET = 0
+CONNECT_CC_OFFSET        = 1
+DISCONNECT_CC_OFFSET     = 2
+
+# ConnectCmd Transport values, must agree with the EDS Transport definitions
+
+TRANSPORT_INI = 0
+TRANSPORT_UDP = 3
+
+
+class CmdSender:
+    """Send EDS packed CCSDS commands to cFS command ingest"""
+
+    def __init__(self, host, port, mid, base_cc):
+        self.addr    = (host, port)
+        self.mid     = mid
+        self.base_cc = base_cc
+        self.seq     = 0
+        self.sock    = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+    def send(self, cc_offset, payload=b''):
+        length = 2 + len(payload)   # Secondary header plus payload, CCSDS length is total minus 7
+        hdr = struct.pack('>HHH', self.mid, 0xC000 | (self.seq & 0x3FFF), length + 6 - 7)
+        pkt = bytearray(hdr + struct.pack('>BB', self.base_cc + cc_offset, 0) + payload)
+        checksum = 0xFF
+        for b in pkt:
+            checksum ^= b
+        pkt[7] = checksum
+        self.sock.sendto(bytes(pkt), self.addr)
+        self.seq += 1
+
+    def config_execute(self, cycles, delay, free_run, sim_rate=0):
+        """A zero sim_rate free runs as fast as the sim allows"""
+        self.send(CONFIG_EXECUTE_CC_OFFSET, struct.pack('>HHBH', cycles, delay, 1 if free_run else 0, sim_rate))
+
+    def connect(self, transport=0):
+        """An empty address and zero port use the app's ini file values"""
+        self.send(CONNECT_CC_OFFSET, struct.pack('>16sHB', b'', 0, transport))
+
+    def disconnect(self):
+        self.send(DISCONNECT_CC_OFFSET)
+
+
+def percentile(sorted_values, pct):
+    if not sorted_values:
+        return 0.0
+    idx = min(len(sorted_values)-1, int(round(pct/100.0*(len(sorted_values)-1))))
+    return sorted_values[idx]
+
+
+def measure(mock, settle, duration):
+    time.sleep(settle)
+    mock.collect()
+    start = time.monotonic()
+    time.sleep(duration)
+    elapsed = time.monotonic() - start
+    steps, latencies = mock.collect()
+    latencies.sort()
+    return dict(steps=steps,
+                rate=steps/elapsed,
+                p50_ms=1e3*percentile(latencies, 50),
+                p90_ms=1e3*percentile(latencies, 90),
+                p99_ms=1e3*percentile(latencies, 99),
+                max_ms=1e3*(latencies[-1] if latencies else 0.0))
+
+
+def int_list(text):
+    return [int(v) for v in text.split(',') if v]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='BC42_INTF end-to-end throughput benchmark')
+    parser.add_argument('--port', type=int, default=10001, help='mock42 first link port')
+    parser.add_argument('--links', type=int, default=1, help='mock42 links, must agree with the app\'s BC42_LINK_CNT')
+    parser.add_argument('--delay', type=float, default=0.0, help='mock42 response delay in seconds')
+    parser.add_argument('--pad', type=int, default=0, help='mock42 ASCII record padding bytes')
+    parser.add_argument('--udp', action='store_true', help='Serve and command the UDP transport, requires the app\'s BINARY wire protocol')
+    parser.add_argument('--drop', type=float, default=0.0, help='Fraction of UDP sensor datagrams mock42 discards')
+    parser.add_argument('--ci-host', default='127.0.0.1', help='cFS command ingest host')
+    parser.add_argument('--ci-port', type=int, default=1234, help='cFS command ingest UDP port')
+    parser.add_argument('--cmd-mid', type=lambda v: int(v, 0), help='BC42_INTF command message ID, no commands are sent if omitted')
+    parser.add_argument('--base-cc', type=int, default=10, help='APP_C_FW APP_BASE_CC')
+    parser.add_argument('--cycles', type=int_list, default=[1, 5, 10, 20], help='ExecuteMsgCycles sweep')
+    parser.add_argument('--delays', type=int_list, default=[10, 50, 100], help='ExecuteCycleDelay (ms) sweep')
+    parser.add_argument('--free-run', action='store_true', help='Add a free running sweep point')
+    parser.add_argument('--sim-rate', type=int, default=0, help='Sim seconds per wall clock second of the free running point, 0 is unpaced')
+    parser.add_argument('--connect-timeout', type=float, default=30.0, help='Seconds to wait for the app to connect')
+    parser.add_argument('--settle', type=float, default=2.0, help='Seconds to run before each measurement')
+    parser.add_argument('--duration', type=float, default=10.0, help='Seconds measured at each sweep point')
+    parser.add_argument('--min-rate', type=float, default=0.0, help='Fail if a sweep point is below this steps/sec')
+    parser.add_argument('--json', help='Write the results to this file')
+    parser.add_argument('-v', '--verbose', action='store_true')
+    args = parser.parse_args()
+
+    mock = mock42.Mock42(args.port, args.links, args.delay, args.pad, verbose=args.verbose, udp=args.udp, drop=args.drop)
+    mock.start()
+
+    cmd = None
+    if args.cmd_mid is not None:
+        cmd = CmdSender(args.ci_host, args.ci_port, args.cmd_mid, args.base_cc)
+        cmd.connect(TRANSPORT_UDP if args.udp else TRANSPORT_INI)
+
+    results = []
+    failed  = False
+    try:
+        if not mock.wait_connected(args.connect_timeout):
+            print('BC42_INTF did not connect to mock42 within %.0f seconds' % args.connect_timeout)
+            return 2
+        print('Connected using the %s protocol' % mock.links[0].protocol)
+
+        points = [(c, d, False) for c in args.cycles for d in args.delays]
+        if args.free_run:
+            points.append((0, 0, True))
+        if cmd is None:
+            points = [(0, 0, False)]
+
+        print('%10s %10s %10s %10s %10s %10s %10s' % ('Cycles', 'Delay(ms)', 'Steps/s', 'p50(ms)', 'p90(ms)', 'p99(ms)', 'Max(ms)'))
+        for cycles, delay, free_run in points:
+            if cmd is not None:
+                cmd.config_execute(max(cycles, 1), max(delay, 10), free_run, args.sim_rate if free_run else 0)
+            result = measure(mock, args.settle, args.duration)
+            result.update(cycles=cycles, delay_ms=delay, free_run=free_run, protocol=mock.links[0].protocol)
+            results.append(result)
+            label = ('%10s %10s' % ('free', 'run')) if free_run else ('%10d %10d' % (cycles, delay))
+            print('%s %10.1f %10.3f %10.3f %10.3f %10.3f' %
+                  (label, result['rate'], result['p50_ms'], result['p90_ms'], result['p99_ms'], result['max_ms']), flush=True)
+            if result['rate'] < args.min_rate:
+                failed = True
+    finally:
+        if cmd is not None:
+            cmd.disconnect()
+        mock.stop()
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(results, f, indent=2)
+
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,450 @@
+#!/usr/bin/env python3
+"""
+Stand-in 42 simulator socket endpoint for exercising BC42_INTF without a 42
+install.
+
+BC42_INTF's COMM42 object connects to 42 as a client so this script listens
+on the 42 socket port(s). Each connection is served by a thread that emulates
+42's side of a control cycle:
+
+  1. Send one sensor record set
+  2. Wait for the actuator record set
+  3. Wait the configured response delay and advance the sim time
+
+A binary actuator batch frame holds a K step actuator schedule. It is
+answered with the sensor frames of all K steps written together.
+
+The protocol is selected the same way COMM42 selects it. If the first bytes
+received after a connection are a WIRE42 hello frame the binary protocol is
+acknowledged (see fsw/src/wire42.h), otherwise 42's native line-oriented
+ASCII records are used.
+
+With --udp each port is a UDP socket for COMM42's UDP transport. Every
+WIRE42 frame is one datagram, a hello datagram starts a session and the
+binary protocol is always used. An actuator datagram that echoes the Seq of
+the last sensor frame sent is a new command. An older echoed Seq is COMM42
+resending its previous command because the sensor datagrams were lost, so
+they are sent again without advancing the sim. --drop discards that fraction
+of the sensor datagrams to exercise the recovery.
+
+The closed-loop latency of every cycle, measured from the sensor write to the
+actuator read, is kept so benchmark drivers (see bench42.py) can compute
+rates and percentiles.
+
+Usage: mock42.py [--port 10001] [--links 1] [--delay 0] [--pad 0] [--udp [--drop 0]]
+"""
+
+import argparse
+import math
+import random
+import select
+import socket
+import struct
+import threading
+import time
+
+# WIRE42 definitions, must agree with fsw/src/wire42.h
+
+WIRE42_SYNC    = 0x42FE
+WIRE42_VERSION = 1
+WIRE42_HDR     = struct.Struct('<HBBII')   # Sync, Version, Type, Length, Seq
+
+WIRE42_FRAME_HELLO     = 1
+WIRE42_FRAME_HELLO_ACK = 2
+WIRE42_FRAME_SENSOR    = 3
+WIRE42_FRAME_ACTUATOR  = 4
+WIRE42_FRAME_ACTUATOR_BATCH = 5
+
+WIRE42_SENSOR_PAYLOAD   = struct.Struct('<I24d')   # Flags, Time, PosN[3], VelN[3], qbn[4], wbn[3], svb[3], bvb[3], WhlH[4]
+WIRE42_ACTUATOR_PAYLOAD = struct.Struct('<7d')     # Tcmd[3], Mcmd[3], SaGcmd
+WIRE42_HELLO_PAYLOAD    = struct.Struct('<II')     # Sensor payload length, actuator payload length
+WIRE42_BATCH_STEPS      = struct.Struct('<I')      # Actuator batch step count, followed by that many actuator payloads
+
+WIRE42_SENSOR_FLAG_SUN_VALID = 0x00000001
+
+ASCII_EOF = b'[EOF]'
+
+PROTOCOL_ASCII  = 'ASCII'
+PROTOCOL_BINARY = 'BINARY'
+
+
+class SimState:
+    """Minimal spacecraft state that changes every step so the app sees live data"""
+
+    def __init__(self, dt):
+        self.dt   = dt
+        self.time = 0.0
+        self.step = 0
+
+    def advance(self):
+        self.step += 1
+        self.time += self.dt
+
+    def sensor_values(self):
+        t  = self.time
+        w  = 0.001
+        ang = 0.5*w*t
+        qbn  = [0.0, 0.0, math.sin(ang), math.cos(ang)]
+        wbn  = [0.0, 0.0, w]
+        svb  = [math.cos(w*t), math.sin(w*t), 0.0]
+        bvb  = [2.0e-5, -1.0e-5, 3.0e-5]
+        posn = [7.0e6*math.cos(1.0e-3*t), 7.0e6*math.sin(1.0e-3*t), 0.0]
+        veln = [-7.0e3*math.sin(1.0e-3*t), 7.0e3*math.cos(1.0e-3*t), 0.0]
+        whlh = [0.01, -0.01, 0.02, 0.0]
+        return dict(Time=t, PosN=posn, VelN=veln, qbn=qbn, wbn=wbn, svb=svb, bvb=bvb, WhlH=whlh, SunValid=True)
+
+
+class LinkStats:
+    """Per connection cycle statistics, latencies are in seconds"""
+
+    def __init__(self):
+        self.lock      = threading.Lock()
+        self.steps     = 0
+        self.latencies = []
+
+    def add(self, latency, steps=1):
+        with self.lock:
+            self.steps += steps
+            self.latencies.append(latency)
+
+    def snapshot_and_clear(self):
+        with self.lock:
+            steps, latencies = self.steps, self.latencies
+            self.steps, self.latencies = 0, []
+        return steps, latencies
+
+
+class Mock42Link(threading.Thread):
+    """Serve one BC42_INTF link connection at a time on a listening port"""
+
+    def __init__(self, port, delay, pad, dt, hello_wait, verbose=False):
+        super().__init__(daemon=True)
+        self.port       = port
+        self.delay      = delay
+        self.pad        = pad
+        self.hello_wait = hello_wait
+        self.verbose    = verbose
+        self.sim        = SimState(dt)
+        self.stats      = LinkStats()
+        self.protocol   = None
+        self.connected  = threading.Event()
+        self.stopping   = threading.Event()
+        self.tx_seq     = 0
+        self.rx_buf     = b''
+        self.listener   = self.listen(port)
+
+    def listen(self, port):
+        listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        listener.bind(('', port))
+        listener.listen(1)
+        return listener
+
+    def log(self, msg):
+        if self.verbose:
+            print('mock42[%d]: %s' % (self.port, msg), flush=True)
+
+    def stop(self):
+        self.stopping.set()
+        try:
+            self.listener.close()
+        except OSError:
+            pass
+
+    def run(self):
+        while not self.stopping.is_set():
+            try:
+                conn, addr = self.listener.accept()
+            except OSError:
+                break
+            conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self.log('connection from %s:%d' % addr)
+            try:
+                self.serve(conn)
+            except (OSError, ConnectionError) as err:
+                self.log('connection closed: %s' % err)
+            finally:
+                self.connected.clear()
+                conn.close()
+
+    # Connection handling
+
+    def recv_some(self, conn, timeout=None):
+        ready, _, _ = select.select([conn], [], [], timeout)
+        if not ready:
+            return False
+        data = conn.recv(65536)
+        if not data:
+            raise ConnectionError('peer closed')
+        self.rx_buf += data
+        return True
+
+    def serve(self, conn):
+        self.rx_buf   = b''
+        self.tx_seq   = 0
+        self.protocol = PROTOCOL_ASCII
+        # COMM42 sends a hello immediately after connecting when BINARY is configured
+        deadline = time.monotonic() + self.hello_wait
+        while len(self.rx_buf) < WIRE42_HDR.size + WIRE42_HELLO_PAYLOAD.size:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0 or not self.recv_some(conn, remaining):
+                break
+        if len(self.rx_buf) >= WIRE42_HDR.size:
+            sync, version, ftype, length, _ = WIRE42_HDR.unpack_from(self.rx_buf)
+            if sync == WIRE42_SYNC and ftype == WIRE42_FRAME_HELLO:
+                self.rx_buf = self.rx_buf[WIRE42_HDR.size + length:]
+                self.send_frame(conn, WIRE42_FRAME_HELLO_ACK,
+                                WIRE42_HELLO_PAYLOAD.pack(WIRE42_SENSOR_PAYLOAD.size, WIRE42_ACTUATOR_PAYLOAD.size))
+                self.protocol = PROTOCOL_BINARY
+        self.log('using %s protocol' % self.protocol)
+        self.connected.set()
+
+        steps = 1
+        while not self.stopping.is_set():
+            sent = time.monotonic()
+            self.send_sensor(conn, steps)
+            next_steps = self.recv_actuator(conn)
+            self.stats.add(time.monotonic() - sent, steps)
+            steps = next_steps
+            self.sim.advance()
+            if self.delay > 0:
+                time.sleep(self.delay)
+
+    # Sensor data
+
+    def send_frame(self, conn, ftype, payload):
+        conn.sendall(self.frame(ftype, payload))
+
+    def frame(self, ftype, payload):
+        frame = WIRE42_HDR.pack(WIRE42_SYNC, WIRE42_VERSION, ftype, len(payload), self.tx_seq) + payload
+        self.tx_seq = (self.tx_seq + 1) & 0xFFFFFFFF
+        return frame
+
+    def send_sensor(self, conn, steps=1):
+        """Batched steps are advanced here and written with one send"""
+        if self.protocol == PROTOCOL_BINARY:
+            frames = []
+            for step in range(steps):
+                if step > 0:
+                    self.sim.advance()
+                v = self.sim.sensor_values()
+                flags = WIRE42_SENSOR_FLAG_SUN_VALID if v['SunValid'] else 0
+                payload = WIRE42_SENSOR_PAYLOAD.pack(flags, v['Time'], *(v['PosN'] + v['VelN'] + v['qbn'] + v['wbn'] +
+                                                                          v['svb'] + v['bvb'] + v['WhlH']))
+                frames.append(self.frame(WIRE42_FRAME_SENSOR, payload))
+            conn.sendall(b''.join(frames))
+        else:
+            v = self.sim.sensor_values()
+            conn.sendall(self.format_ascii(v))
+
+    def format_ascii(self, v):
+        """42 AcApp socket records. Readers skip lines they don't recognize so pad lines are ignored"""
+        def vec(x):
+            return ' '.join('%18.12le' % e for e in x)
+        lines = ['TIME %.9lf' % v['Time'],
+                 'SC[0].AC.Time = %18.12le' % v['Time'],
+                 'SC[0].AC.PosN = %s' % vec(v['PosN']),
+                 'SC[0].AC.VelN = %s' % vec(v['VelN']),
+                 'SC[0].AC.qbn = %s' % vec(v['qbn']),
+                 'SC[0].AC.wbn = %s' % vec(v['wbn']),
+                 'SC[0].AC.svb = %s' % vec(v['svb']),
+                 'SC[0].AC.bvb = %s' % vec(v['bvb']),
+                 'SC[0].AC.SunValid = %d' % (1 if v['SunValid'] else 0)]
+        for i in range(3):
+            lines.append('SC[0].AC.Gyro[%d].Rate = %18.12le' % (i, v['wbn'][i]))
+            lines.append('SC[0].AC.MAG[%d].Field = %18.12le' % (i, v['bvb'][i]))
+        lines.append('SC[0].AC.ST[0].Valid = 1')
+        lines.append('SC[0].AC.ST[0].qn = %s' % vec(v['qbn']))
+        lines.append('SC[0].AC.GPS[0].Valid = 1')
+        lines.append('SC[0].AC.GPS[0].PosN = %s' % vec(v['PosN']))
+        lines.append('SC[0].AC.GPS[0].VelN = %s' % vec(v['VelN']))
+        for i in range(4):
+            lines.append('SC[0].AC.Whl[%d].H = %18.12le' % (i, v['WhlH'][i]))
+        text = '\n'.join(lines) + '\n'
+        if self.pad > 0:
+            pad_line = 'SC[0].AC.Pad = ' + 'x'*60 + '\n'
+            text += pad_line * max(1, self.pad // len(pad_line))
+        return text.encode('ascii') + ASCII_EOF + b'\n\n'
+
+    # Actuator commands
+
+    def recv_actuator(self, conn):
+        """Return the number of steps commanded"""
+        if self.protocol == PROTOCOL_BINARY:
+            while True:
+                idx = self.find_sync()
+                if idx >= 0 and len(self.rx_buf) >= idx + WIRE42_HDR.size:
+                    sync, version, ftype, length, _ = WIRE42_HDR.unpack_from(self.rx_buf, idx)
+                    end = idx + WIRE42_HDR.size + length
+                    if len(self.rx_buf) >= end:
+                        payload = self.rx_buf[idx + WIRE42_HDR.size:end]
+                        self.rx_buf = self.rx_buf[end:]
+                        if ftype == WIRE42_FRAME_ACTUATOR:
+                            return 1
+                        if ftype == WIRE42_FRAME_ACTUATOR_BATCH and length >= WIRE42_BATCH_STEPS.size:
+                            return max(1, WIRE42_BATCH_STEPS.unpack_from(payload)[0])
+                        continue
+                self.recv_some(conn)
+        else:
+            while ASCII_EOF not in self.rx_buf:
+                self.recv_some(conn)
+            idx = self.rx_buf.index(ASCII_EOF) + len(ASCII_EOF)
+            self.rx_buf = self.rx_buf[idx:].lstrip(b'\n')
+            return 1
+
+    def find_sync(self):
+        sync = struct.pack('<H', WIRE42_SYNC)
+        idx = self.rx_buf.find(sync)
+        if idx > 0:
+            self.rx_buf = self.rx_buf[idx:]
+            idx = 0
+        elif idx < 0:
+            self.rx_buf = self.rx_buf[-1:]
+        return idx
+
+
+class Mock42UdpLink(Mock42Link):
+    """Serve one BC42_INTF link's UDP datagrams on a port, one WIRE42 frame per datagram"""
+
+    def __init__(self, port, delay, pad, dt, hello_wait, drop=0.0, verbose=False):
+        super().__init__(port, delay, pad, dt, hello_wait, verbose)
+        self.drop     = drop
+        self.peer     = None
+        self.sent     = []    # Sensor datagrams of the current exchange
+        self.resends  = 0
+
+    def listen(self, port):
+        listener = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        listener.bind(('', port))
+        return listener
+
+    def run(self):
+        steps = 1
+        sent  = time.monotonic()
+        while not self.stopping.is_set():
+            try:
+                data, addr = self.listener.recvfrom(65536)
+            except OSError:
+                break
+            if len(data) < WIRE42_HDR.size:
+                continue
+            sync, version, ftype, length, seq = WIRE42_HDR.unpack_from(data)
+            if sync != WIRE42_SYNC or len(data) != WIRE42_HDR.size + length:
+                continue
+            if ftype == WIRE42_FRAME_HELLO:
+                self.peer     = addr
+                self.tx_seq   = 0
+                self.protocol = PROTOCOL_BINARY
+                self.log('session from %s:%d' % addr)
+                self.sendto(self.frame(WIRE42_FRAME_HELLO_ACK,
+                                       WIRE42_HELLO_PAYLOAD.pack(WIRE42_SENSOR_PAYLOAD.size, WIRE42_ACTUATOR_PAYLOAD.size)))
+                self.connected.set()
+                steps = 1
+            elif addr != self.peer or ftype not in (WIRE42_FRAME_ACTUATOR, WIRE42_FRAME_ACTUATOR_BATCH):
+                continue
+            elif ((self.tx_seq - 1 - seq) & 0xFFFFFFFF) != 0:
+                self.resends += 1
+                self.log('resending %d sensor datagrams for actuator echo %d' % (len(self.sent), seq))
+                for datagram in self.sent:
+                    self.sendto(datagram)
+                continue
+            else:
+                self.stats.add(time.monotonic() - sent, steps)
+                steps = 1
+                if ftype == WIRE42_FRAME_ACTUATOR_BATCH and length >= WIRE42_BATCH_STEPS.size:
+                    steps = max(1, WIRE42_BATCH_STEPS.unpack_from(data, WIRE42_HDR.size)[0])
+                self.sim.advance()
+                if self.delay > 0:
+                    time.sleep(self.delay)
+            sent = time.monotonic()
+            self.send_sensor(None, steps)
+
+    def sendto(self, datagram):
+        try:
+            self.listener.sendto(datagram, self.peer)
+        except OSError as err:
+            self.log('send failed: %s' % err)
+
+    def send_sensor(self, conn, steps=1):
+        """Each step's sensor frame is its own datagram, dropped datagrams are kept for a resend"""
+        self.sent = []
+        for step in range(steps):
+            if step > 0:
+                self.sim.advance()
+            v = self.sim.sensor_values()
+            flags = WIRE42_SENSOR_FLAG_SUN_VALID if v['SunValid'] else 0
+            payload = WIRE42_SENSOR_PAYLOAD.pack(flags, v['Time'], *(v['PosN'] + v['VelN'] + v['qbn'] + v['wbn'] +
+                                                                      v['svb'] + v['bvb'] + v['WhlH']))
+            self.sent.append(self.frame(WIRE42_FRAME_SENSOR, payload))
+        for datagram in self.sent:
+            if random.random() >= self.drop:
+                self.sendto(datagram)
+
+
+class Mock42:
+    """One Mock42Link per BC42_INTF link, ports are consecutive"""
+
+    def __init__(self, port=10001, links=1, delay=0.0, pad=0, dt=0.1, hello_wait=0.25, verbose=False, udp=False, drop=0.0):
+        if udp:
+            self.links = [Mock42UdpLink(port + i, delay, pad, dt, hello_wait, drop, verbose) for i in range(links)]
+        else:
+            self.links = [Mock42Link(port + i, delay, pad, dt, hello_wait, verbose) for i in range(links)]
+
+    def start(self):
+        for link in self.links:
+            link.start()
+
+    def stop(self):
+        for link in self.links:
+            link.stop()
+
+    def wait_connected(self, timeout):
+        deadline = time.monotonic() + timeout
+        for link in self.links:
+            if not link.connected.wait(max(0.0, deadline - time.monotonic())):
+                return False
+        return True
+
+    def collect(self):
+        """Return the steps and latencies of every link since the previous collect"""
+        steps, latencies = 0, []
+        for link in self.links:
+            s, l = link.stats.snapshot_and_clear()
+            steps += s
+            latencies += l
+        return steps, latencies
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Stand-in 42 socket endpoint for BC42_INTF')
+    parser.add_argument('--port', type=int, default=10001, help='First link port, 42 standalone default is 10001')
+    parser.add_argument('--links', type=int, default=1, help='Number of links, ports are consecutive')
+    parser.add_argument('--delay', type=float, default=0.0, help='Seconds to wait after each actuator command, emulates 42 step time')
+    parser.add_argument('--pad', type=int, default=0, help='Approximate bytes of ignored lines added to each ASCII sensor record set')
+    parser.add_argument('--dt', type=float, default=0.1, help='Sim seconds per step')
+    parser.add_argument('--report', type=float, default=5.0, help='Seconds between rate reports')
+    parser.add_argument('--udp', action='store_true', help='Serve COMM42\'s UDP transport, one WIRE42 frame per datagram')
+    parser.add_argument('--drop', type=float, default=0.0, help='Fraction of UDP sensor datagrams discarded')
+    parser.add_argument('-v', '--verbose', action='store_true')
+    args = parser.parse_args()
+
+    mock = Mock42(args.port, args.links, args.delay, args.pad, args.dt, verbose=args.verbose, udp=args.udp, drop=args.drop)
+    mock.start()
+    print('mock42 listening on port(s) %s' % ', '.join(str(l.port) for l in mock.links), flush=True)
+    try:
+        while True:
+            time.sleep(args.report)
+            steps, latencies = mock.collect()
+            if steps:
+                latencies.sort()
+                print('%8.1f steps/s  p50 %.3f ms  max %.3f ms' %
+                      (steps/args.report, 1e3*latencies[len(latencies)//2], 1e3*latencies[-1]), flush=True)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        mock.stop()
+
+
+if __name__ == '__main__':
+    main()